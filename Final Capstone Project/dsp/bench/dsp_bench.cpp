@@ -0,0 +1,148 @@
+// DSP kernel benchmarks. Bit-exactness of the two paths is checked by
+// g7_dsp_test.
+//
+//   ./g7_dsp_bench --benchmark_counters_tabular=true
+//
+// Counters: items_per_second is samples/s (complex points/s for the FFT),
+// cycles/sample is measured with g7::cycles.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "g7/cycles.hpp"
+#include "g7/dsp.hpp"
+#include "signals.hpp"
+
+namespace dsp = g7::dsp;
+using dsp::Path;
+using dsp::q15_t;
+using dsp::q31_t;
+using namespace g7::dsp::test;
+
+namespace {
+
+Path path_arg(const benchmark::State& state) { return state.range(0) ? Path::Simd : Path::Scalar; }
+
+void finish(benchmark::State& state, std::uint64_t cycles, std::size_t samples_per_iter) {
+    const auto samples = state.iterations() * static_cast<std::int64_t>(samples_per_iter);
+    state.SetItemsProcessed(samples);
+    state.counters["cycles/sample"] = static_cast<double>(cycles) / static_cast<double>(samples);
+    state.SetLabel(state.range(0) ? dsp::simd_name() : "scalar");
+}
+
+void BM_FirQ15(benchmark::State& state) {
+    const auto taps = static_cast<std::size_t>(state.range(1));
+    const auto coeffs = lowpass_q15(taps, 0.1);
+    const auto in = random_q15(kBlock, 1);
+    std::vector<q15_t> out(kBlock), st(taps - 1 + kBlock);
+    dsp::FirQ15 f;
+    f.init(static_cast<std::uint16_t>(taps), coeffs.data(), st.data(), kBlock);
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        dsp::fir(f, in.data(), out.data(), kBlock, path_arg(state));
+        benchmark::DoNotOptimize(out.data());
+    }
+    finish(state, g7::cycles::now() - c0, kBlock);
+}
+BENCHMARK(BM_FirQ15)->ArgNames({"simd", "taps"})->ArgsProduct({{0, 1}, {16, 64}});
+
+void BM_FirQ31(benchmark::State& state) {
+    const auto taps = static_cast<std::size_t>(state.range(1));
+    const auto coeffs = random_q31(taps, 2);
+    const auto in = random_q31(kBlock, 1);
+    std::vector<q31_t> out(kBlock), st(taps - 1 + kBlock);
+    dsp::FirQ31 f;
+    f.init(static_cast<std::uint16_t>(taps), coeffs.data(), st.data(), kBlock);
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        dsp::fir(f, in.data(), out.data(), kBlock, path_arg(state));
+        benchmark::DoNotOptimize(out.data());
+    }
+    finish(state, g7::cycles::now() - c0, kBlock);
+}
+BENCHMARK(BM_FirQ31)->ArgNames({"simd", "taps"})->ArgsProduct({{0, 1}, {16, 64}});
+
+void BM_FirDecimateQ15(benchmark::State& state) {
+    constexpr std::size_t taps = 32;
+    const auto factor = static_cast<std::uint8_t>(state.range(1));
+    const auto coeffs = lowpass_q15(taps, 0.5 / factor);
+    const auto in = random_q15(kBlock, 1);
+    std::vector<q15_t> out(kBlock), st(taps - 1 + kBlock);
+    dsp::FirDecimateQ15 f;
+    f.init(taps, factor, coeffs.data(), st.data(), kBlock);
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        dsp::fir_decimate(f, in.data(), out.data(), kBlock, path_arg(state));
+        benchmark::DoNotOptimize(out.data());
+    }
+    finish(state, g7::cycles::now() - c0, kBlock);
+}
+BENCHMARK(BM_FirDecimateQ15)->ArgNames({"simd", "M"})->ArgsProduct({{0, 1}, {4}});
+
+void BM_BiquadQ15(benchmark::State& state) {
+    const auto in = random_q15(kBlock, 1);
+    std::vector<q15_t> out(kBlock);
+    q15_t st[4];
+    dsp::BiquadQ15 f;
+    f.init(1, kBiquadQ15, st, 1);
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        dsp::biquad(f, in.data(), out.data(), kBlock, path_arg(state));
+        benchmark::DoNotOptimize(out.data());
+    }
+    finish(state, g7::cycles::now() - c0, kBlock);
+}
+BENCHMARK(BM_BiquadQ15)->ArgNames({"simd"})->Arg(0)->Arg(1);
+
+void BM_BiquadQ31(benchmark::State& state) {
+    const auto in = random_q31(kBlock, 1);
+    std::vector<q31_t> out(kBlock);
+    q31_t st[4];
+    dsp::BiquadQ31 f;
+    f.init(1, kBiquadQ31, st, 1);
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        dsp::biquad(f, in.data(), out.data(), kBlock, path_arg(state));
+        benchmark::DoNotOptimize(out.data());
+    }
+    finish(state, g7::cycles::now() - c0, kBlock);
+}
+BENCHMARK(BM_BiquadQ31)->ArgNames({"simd"})->Arg(0)->Arg(1);
+
+void BM_MovingAverageQ15(benchmark::State& state) {
+    const auto window = static_cast<std::uint16_t>(state.range(1));
+    const auto in = random_q15(kBlock, 1);
+    std::vector<q15_t> out(kBlock), st(window + kBlock);
+    dsp::MovingAverageQ15 f;
+    f.init(window, st.data(), kBlock);
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        dsp::moving_average(f, in.data(), out.data(), kBlock, path_arg(state));
+        benchmark::DoNotOptimize(out.data());
+    }
+    finish(state, g7::cycles::now() - c0, kBlock);
+}
+BENCHMARK(BM_MovingAverageQ15)->ArgNames({"simd", "W"})->ArgsProduct({{0, 1}, {16}});
+
+void BM_CfftQ15(benchmark::State& state) {
+    const auto len = static_cast<std::uint32_t>(state.range(1));
+    const auto in = random_q15(2 * len, 1);
+    std::vector<q15_t> data(2 * len), scratch(2 * len), tw(4 * len);
+    dsp::CfftQ15 f;
+    f.init(len, tw.data());
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        std::memcpy(data.data(), in.data(), data.size() * sizeof(q15_t));
+        dsp::cfft(f, data.data(), scratch.data(), path_arg(state));
+        benchmark::DoNotOptimize(data.data());
+    }
+    finish(state, g7::cycles::now() - c0, len);
+}
+BENCHMARK(BM_CfftQ15)->ArgNames({"simd", "N"})->ArgsProduct({{0, 1}, {64, 256, 1024, 4096}});
+
+}  // namespace
+
+BENCHMARK_MAIN();
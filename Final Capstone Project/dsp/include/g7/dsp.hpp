@@ -0,0 +1,8 @@
+// Fixed-point DSP kernels for the capstone sensor pipelines.
+#pragma once
+
+#include "g7/dsp/biquad.hpp"
+#include "g7/dsp/fft.hpp"
+#include "g7/dsp/fir.hpp"
+#include "g7/dsp/moving_average.hpp"
+#include "g7/dsp/q.hpp"
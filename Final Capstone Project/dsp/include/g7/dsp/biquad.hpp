@@ -0,0 +1,54 @@
+// Direct form I biquad cascades.
+//
+// Layout and arithmetic follow CMSIS-DSP arm_biquad_cascade_df1_{q15,q31}:
+//
+//   y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]
+//
+// Note the feedback signs: a1/a2 are the negated denominator coefficients of
+// the usual transfer function. Coefficients are scaled by 2^-post_shift so
+// values outside [-1, 1) fit; the accumulator is shifted right by
+// (15 - post_shift) or (31 - post_shift) and saturated.
+//
+//   Q15 coeffs per stage: {b0, 0, b1, b2, a1, a2}   (6 entries, SMLAD pairs)
+//   Q31 coeffs per stage: {b0, b1, b2, a1, a2}      (5 entries)
+//   State per stage:      {x[n-1], x[n-2], y[n-1], y[n-2]}
+//
+// The SIMD path computes the feed-forward part of a block with vector
+// multiplies and leaves only the two-tap recursion serial. For Q15 that does
+// not pay for the extra passes, so Path::Auto selects the scalar kernel; pass
+// Path::Simd to force it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/dsp/q.hpp"
+
+namespace g7::dsp {
+
+struct BiquadQ15 {
+    std::uint8_t num_stages = 0;
+    std::int8_t post_shift = 0;
+    const q15_t* coeffs = nullptr;  // 6 * num_stages
+    q15_t* state = nullptr;         // 4 * num_stages
+    bool simd_ok = false;
+
+    void init(std::uint8_t stages, const q15_t* stage_coeffs, q15_t* state_buf,
+              std::int8_t shift);
+};
+
+struct BiquadQ31 {
+    std::uint8_t num_stages = 0;
+    std::int8_t post_shift = 0;
+    const q31_t* coeffs = nullptr;  // 5 * num_stages
+    q31_t* state = nullptr;         // 4 * num_stages
+
+    void init(std::uint8_t stages, const q31_t* stage_coeffs, q31_t* state_buf,
+              std::int8_t shift);
+};
+
+// src and dst may alias.
+void biquad(BiquadQ15& f, const q15_t* src, q15_t* dst, std::size_t n, Path path = Path::Auto);
+void biquad(BiquadQ31& f, const q31_t* src, q31_t* dst, std::size_t n, Path path = Path::Auto);
+
+}  // namespace g7::dsp
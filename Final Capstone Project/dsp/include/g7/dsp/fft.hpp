@@ -0,0 +1,36 @@
+// Complex Q15 FFT, mixed radix-4/radix-2.
+//
+// Data is interleaved {re, im} Q15, like arm_cfft_q15. Each radix-4 stage
+// pre-scales its inputs by 1/4 and each radix-2 stage by 1/2, so the output
+// is the DFT scaled by 1/N and never overflows. Lengths that are an odd
+// power of two run one radix-2 stage first.
+//
+// The transform is a Stockham autosort FFT: stages ping-pong between the data
+// buffer and a caller-provided scratch buffer, so no bit reversal pass is
+// needed and every stage reads and writes unit-stride runs. The SIMD path
+// vectorises across those runs once they are at least eight points long.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/dsp/q.hpp"
+
+namespace g7::dsp {
+
+struct CfftQ15 {
+    std::uint32_t length = 0;   // power of two, 4 .. 65536
+    std::uint8_t log2_length = 0;
+    // Per twiddle k = 0 .. length-1, with c = cos(2*pi*k/length) and
+    // s = sin(2*pi*k/length), the two Q15 pairs {c, s} and {-s, c}; a complex
+    // multiply by e^(-j*2*pi*k/length) is then two pairwise multiply-adds.
+    q15_t* twiddles = nullptr;  // 4 * length entries
+
+    // Fills `twiddle_buf`. Returns false for unsupported lengths.
+    bool init(std::uint32_t n, q15_t* twiddle_buf);
+};
+
+// Forward transform in place. `data` and `scratch` hold 2 * length entries.
+void cfft(const CfftQ15& f, q15_t* data, q15_t* scratch, Path path = Path::Auto);
+
+}  // namespace g7::dsp
@@ -0,0 +1,72 @@
+// FIR filters and FIR decimators.
+//
+// Instances follow the CMSIS-DSP layout (arm_fir_instance_q15 and friends):
+// coefficients are stored time-reversed, coeffs[0] = b[num_taps - 1], and the
+// caller owns a state buffer of num_taps - 1 + block_size samples. Output
+// sample y[n] is the dot product of the coefficients with the num_taps
+// newest inputs, so each output reads one contiguous window of the state.
+//
+//   Q15: 64-bit accumulator of 1.15 x 1.15 products, >> 15, saturated.
+//   Q31: 64-bit wrapping accumulator of 1.31 x 1.31 products, >> 31, saturated.
+//
+// The Q15 SIMD path pairs products in 32-bit lanes, which is exact unless a
+// coefficient is -1.0 (-32768); init() disables the SIMD path in that case.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/dsp/q.hpp"
+
+namespace g7::dsp {
+
+struct FirQ15 {
+    std::uint16_t num_taps = 0;
+    std::size_t block_size = 0;
+    const q15_t* coeffs = nullptr;  // time-reversed, num_taps entries
+    q15_t* state = nullptr;         // num_taps - 1 + block_size entries
+    bool simd_ok = false;
+
+    void init(std::uint16_t taps, const q15_t* reversed_coeffs, q15_t* state_buf,
+              std::size_t block);
+};
+
+struct FirQ31 {
+    std::uint16_t num_taps = 0;
+    std::size_t block_size = 0;
+    const q31_t* coeffs = nullptr;
+    q31_t* state = nullptr;
+
+    void init(std::uint16_t taps, const q31_t* reversed_coeffs, q31_t* state_buf,
+              std::size_t block);
+};
+
+// FIR followed by keeping every `factor`-th output; only the kept outputs are
+// computed. Matches arm_fir_decimate_instance_q15: block_size must be a
+// multiple of factor, and state holds num_taps - 1 + block_size samples.
+struct FirDecimateQ15 {
+    std::uint16_t num_taps = 0;
+    std::uint8_t factor = 1;
+    std::size_t block_size = 0;
+    const q15_t* coeffs = nullptr;
+    q15_t* state = nullptr;
+    bool simd_ok = false;
+
+    void init(std::uint16_t taps, std::uint8_t decimation, const q15_t* reversed_coeffs,
+              q15_t* state_buf, std::size_t block);
+};
+
+// Filters n samples; any n is accepted and processed in block_size chunks.
+void fir(FirQ15& f, const q15_t* src, q15_t* dst, std::size_t n, Path path = Path::Auto);
+void fir(FirQ31& f, const q31_t* src, q31_t* dst, std::size_t n, Path path = Path::Auto);
+
+// Consumes n input samples (a multiple of factor) and writes n / factor outputs.
+void fir_decimate(FirDecimateQ15& f, const q15_t* src, q15_t* dst, std::size_t n,
+                  Path path = Path::Auto);
+
+// Hann-windowed sinc low-pass with `cutoff` in cycles per sample (0, 0.5).
+// Writes `taps` time-reversed Q15 coefficients, ready for init(), scaled to
+// a DC gain of 0.95 so a full-scale step does not saturate.
+void fir_lowpass_q15(q15_t* reversed_coeffs, std::size_t taps, double cutoff);
+
+}  // namespace g7::dsp
@@ -0,0 +1,30 @@
+// Boxcar moving average over a power-of-two window.
+//
+//   y[n] = (x[n] + x[n-1] + ... + x[n-W+1]) >> log2(W)
+//
+// A running 32-bit sum is updated with x[n] - x[n-W] per sample, so the cost
+// is independent of W. The SIMD path turns the block of differences into
+// running sums with a parallel prefix scan.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/dsp/q.hpp"
+
+namespace g7::dsp {
+
+struct MovingAverageQ15 {
+    std::uint16_t window = 0;  // power of two, at most 32768
+    std::uint8_t shift = 0;    // log2(window)
+    std::size_t block_size = 0;
+    q15_t* state = nullptr;    // window + block_size entries
+    std::int32_t sum = 0;
+
+    void init(std::uint16_t window_len, q15_t* state_buf, std::size_t block);
+};
+
+void moving_average(MovingAverageQ15& f, const q15_t* src, q15_t* dst, std::size_t n,
+                    Path path = Path::Auto);
+
+}  // namespace g7::dsp
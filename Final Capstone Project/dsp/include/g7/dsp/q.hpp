@@ -0,0 +1,62 @@
+// Fixed-point types and helpers shared by the DSP kernels.
+//
+// Q15 samples are int16 in [-1, 1); Q31 samples are int32 in [-1, 1). Every
+// kernel has a scalar reference path and a SIMD path (AVX2 on x86 hosts). The
+// two paths are bit-exact: integer accumulations are order-independent, and
+// wherever the SIMD path rounds or saturates the reference does the same.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace g7::dsp {
+
+using q15_t = std::int16_t;
+using q31_t = std::int32_t;
+using q63_t = std::int64_t;
+
+// Selects the implementation of a kernel. Auto picks Simd when the CPU
+// supports it and the instance allows it, and Scalar otherwise.
+enum class Path { Auto, Scalar, Simd };
+
+// True when the SIMD paths were compiled in and the running CPU supports them.
+bool simd_available();
+// "avx2" or "none".
+const char* simd_name();
+
+inline q15_t sat_q15(q63_t v) {
+    return static_cast<q15_t>(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+inline q31_t sat_q31(q63_t v) {
+    return static_cast<q31_t>(v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : v);
+}
+
+// Wrapping 64-bit add, matching the modular adds of the SIMD accumulators.
+inline q63_t add_wrap(q63_t a, q63_t b) {
+    return static_cast<q63_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+}
+
+// Rounded Q15 multiply, (a * b + 0x4000) >> 15, as x86 PMULHRSW computes it.
+// Only -1 * -1 overflows, and it wraps to -1 as on x86 (ARM QRDMULH
+// saturates instead); the FFT twiddles never take the value -1.
+inline q15_t mulr_q15(q15_t a, q15_t b) {
+    return static_cast<q15_t>((static_cast<std::int32_t>(a) * b + 0x4000) >> 15);
+}
+
+inline q15_t adds_q15(q15_t a, q15_t b) { return sat_q15(static_cast<std::int32_t>(a) + b); }
+inline q15_t subs_q15(q15_t a, q15_t b) { return sat_q15(static_cast<std::int32_t>(a) - b); }
+
+inline q15_t float_to_q15(float f) {
+    const float s = f * 32768.0f;
+    return sat_q15(static_cast<q63_t>(s < 0 ? s - 0.5f : s + 0.5f));
+}
+
+inline q31_t float_to_q31(double f) {
+    const double s = f * 2147483648.0;
+    return sat_q31(static_cast<q63_t>(s < 0 ? s - 0.5 : s + 0.5));
+}
+
+inline float q15_to_float(q15_t v) { return static_cast<float>(v) / 32768.0f; }
+
+}  // namespace g7::dsp
@@ -0,0 +1,104 @@
+// Block kernels behind the public DSP API. dsp.cpp owns state handling and
+// path selection; the kernels only see contiguous windows.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/dsp/q.hpp"
+
+namespace g7::dsp::detail {
+
+// One implementation set per path. Signatures are identical so dispatch is a
+// table pick; see dsp.cpp.
+struct Kernels {
+    // dst[i] = sat(sum_k c[k] * x[i * stride + k] >> 15), i < count
+    void (*fir_q15)(const q15_t* c, std::size_t taps, const q15_t* x, q15_t* dst,
+                    std::size_t count, std::size_t stride);
+    // dst[i] = sat(wrapsum_k c[k] * x[i + k] >> 31), i < count
+    void (*fir_q31)(const q31_t* c, std::size_t taps, const q31_t* x, q31_t* dst,
+                    std::size_t count);
+    // One biquad stage over n samples; updates the 4-entry state.
+    void (*biquad_q15)(const q15_t* c, q15_t* state, int shift, const q15_t* src, q15_t* dst,
+                       std::size_t n);
+    void (*biquad_q31)(const q31_t* c, q31_t* state, int shift, const q31_t* src, q31_t* dst,
+                       std::size_t n);
+    // x points at window + n samples: x[i] leaves and x[i + window] enters.
+    void (*moving_average_q15)(const q15_t* x, std::size_t window, int shift, std::int32_t* sum,
+                               q15_t* dst, std::size_t n);
+    // Stockham stages over complex int16 pairs. n is the current sub-length,
+    // s the stride, tw the twiddle table and tw_step = length / n.
+    void (*fft_radix4_q15)(std::size_t n, std::size_t s, const q15_t* x, q15_t* y,
+                           const q15_t* tw, std::size_t tw_step);
+    void (*fft_radix2_q15)(std::size_t n, std::size_t s, const q15_t* x, q15_t* y,
+                           const q15_t* tw, std::size_t tw_step);
+};
+
+extern const Kernels kScalar;
+// Null when the SIMD kernels were not compiled in or the CPU lacks them.
+const Kernels* simd_kernels();
+const char* simd_kernels_name();
+
+// Scalar butterflies shared by both paths for short strides. `x`/`y` index
+// complex points; tw points at one twiddle entry (4 int16s).
+inline void cmul_tw(q15_t& re, q15_t& im, const q15_t* tw) {
+    const q15_t r = re;
+    const q15_t i = im;
+    re = adds_q15(mulr_q15(r, tw[0]), mulr_q15(i, tw[1]));
+    im = adds_q15(mulr_q15(r, tw[2]), mulr_q15(i, tw[3]));
+}
+
+inline void radix4_butterfly(const q15_t* x, q15_t* y, std::size_t n, std::size_t s,
+                             std::size_t p, std::size_t q, const q15_t* tw,
+                             std::size_t tw_step) {
+    const std::size_t m = n / 4;
+    const q15_t* a = x + 2 * (q + s * (p + 0 * m));
+    const q15_t* b = x + 2 * (q + s * (p + 1 * m));
+    const q15_t* c = x + 2 * (q + s * (p + 2 * m));
+    const q15_t* d = x + 2 * (q + s * (p + 3 * m));
+    const q15_t ar = a[0] >> 2, ai = a[1] >> 2, br = b[0] >> 2, bi = b[1] >> 2;
+    const q15_t cr = c[0] >> 2, ci = c[1] >> 2, dr = d[0] >> 2, di = d[1] >> 2;
+
+    const q15_t apc_r = adds_q15(ar, cr), apc_i = adds_q15(ai, ci);
+    const q15_t amc_r = subs_q15(ar, cr), amc_i = subs_q15(ai, ci);
+    const q15_t bpd_r = adds_q15(br, dr), bpd_i = adds_q15(bi, di);
+    const q15_t bmd_r = subs_q15(br, dr), bmd_i = subs_q15(bi, di);
+
+    q15_t* y0 = y + 2 * (q + s * (4 * p + 0));
+    q15_t* y1 = y + 2 * (q + s * (4 * p + 1));
+    q15_t* y2 = y + 2 * (q + s * (4 * p + 2));
+    q15_t* y3 = y + 2 * (q + s * (4 * p + 3));
+
+    y0[0] = adds_q15(apc_r, bpd_r);
+    y0[1] = adds_q15(apc_i, bpd_i);
+    // (a - c) - j(b - d)
+    y1[0] = adds_q15(amc_r, bmd_i);
+    y1[1] = subs_q15(amc_i, bmd_r);
+    y2[0] = subs_q15(apc_r, bpd_r);
+    y2[1] = subs_q15(apc_i, bpd_i);
+    // (a - c) + j(b - d)
+    y3[0] = subs_q15(amc_r, bmd_i);
+    y3[1] = adds_q15(amc_i, bmd_r);
+
+    cmul_tw(y1[0], y1[1], tw + 4 * (1 * p * tw_step));
+    cmul_tw(y2[0], y2[1], tw + 4 * (2 * p * tw_step));
+    cmul_tw(y3[0], y3[1], tw + 4 * (3 * p * tw_step));
+}
+
+inline void radix2_butterfly(const q15_t* x, q15_t* y, std::size_t n, std::size_t s,
+                             std::size_t p, std::size_t q, const q15_t* tw,
+                             std::size_t tw_step) {
+    const std::size_t m = n / 2;
+    const q15_t* a = x + 2 * (q + s * p);
+    const q15_t* b = x + 2 * (q + s * (p + m));
+    const q15_t ar = a[0] >> 1, ai = a[1] >> 1, br = b[0] >> 1, bi = b[1] >> 1;
+    q15_t* y0 = y + 2 * (q + s * (2 * p + 0));
+    q15_t* y1 = y + 2 * (q + s * (2 * p + 1));
+    y0[0] = adds_q15(ar, br);
+    y0[1] = adds_q15(ai, bi);
+    y1[0] = subs_q15(ar, br);
+    y1[1] = subs_q15(ai, bi);
+    cmul_tw(y1[0], y1[1], tw + 4 * (p * tw_step));
+}
+
+}  // namespace g7::dsp::detail
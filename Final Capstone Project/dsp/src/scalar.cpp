@@ -0,0 +1,108 @@
+// Scalar reference kernels. These define the exact output of every kernel;
+// the SIMD kernels must match them bit for bit.
+
+#include "kernels.hpp"
+
+namespace g7::dsp::detail {
+namespace {
+
+void fir_q15(const q15_t* c, std::size_t taps, const q15_t* x, q15_t* dst, std::size_t count,
+             std::size_t stride) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const q15_t* w = x + i * stride;
+        q63_t acc = 0;
+        for (std::size_t k = 0; k < taps; ++k) {
+            acc += static_cast<std::int32_t>(c[k]) * w[k];
+        }
+        dst[i] = sat_q15(acc >> 15);
+    }
+}
+
+void fir_q31(const q31_t* c, std::size_t taps, const q31_t* x, q31_t* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const q31_t* w = x + i;
+        q63_t acc = 0;
+        for (std::size_t k = 0; k < taps; ++k) {
+            acc = add_wrap(acc, static_cast<q63_t>(c[k]) * w[k]);
+        }
+        dst[i] = sat_q31(acc >> 31);
+    }
+}
+
+void biquad_q15(const q15_t* c, q15_t* state, int shift, const q15_t* src, q15_t* dst,
+                std::size_t n) {
+    const std::int32_t b0 = c[0], b1 = c[2], b2 = c[3], a1 = c[4], a2 = c[5];
+    q15_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+    for (std::size_t i = 0; i < n; ++i) {
+        const q15_t x0 = src[i];
+        q63_t acc = static_cast<q63_t>(b0 * x0) + b1 * x1 + b2 * x2;
+        acc += static_cast<q63_t>(a1 * y1) + a2 * y2;
+        const q15_t y0 = sat_q15(acc >> (15 - shift));
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        dst[i] = y0;
+    }
+    state[0] = x1;
+    state[1] = x2;
+    state[2] = y1;
+    state[3] = y2;
+}
+
+void biquad_q31(const q31_t* c, q31_t* state, int shift, const q31_t* src, q31_t* dst,
+                std::size_t n) {
+    const q63_t b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+    q31_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+    for (std::size_t i = 0; i < n; ++i) {
+        const q31_t x0 = src[i];
+        q63_t acc = add_wrap(add_wrap(b0 * x0, b1 * x1), b2 * x2);
+        acc = add_wrap(add_wrap(acc, a1 * y1), a2 * y2);
+        const q31_t y0 = sat_q31(acc >> (31 - shift));
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        dst[i] = y0;
+    }
+    state[0] = x1;
+    state[1] = x2;
+    state[2] = y1;
+    state[3] = y2;
+}
+
+void moving_average_q15(const q15_t* x, std::size_t window, int shift, std::int32_t* sum,
+                        q15_t* dst, std::size_t n) {
+    std::int32_t s = *sum;
+    for (std::size_t i = 0; i < n; ++i) {
+        s += static_cast<std::int32_t>(x[i + window]) - x[i];
+        dst[i] = static_cast<q15_t>(s >> shift);
+    }
+    *sum = s;
+}
+
+void fft_radix4_q15(std::size_t n, std::size_t s, const q15_t* x, q15_t* y, const q15_t* tw,
+                    std::size_t tw_step) {
+    for (std::size_t p = 0; p < n / 4; ++p) {
+        for (std::size_t q = 0; q < s; ++q) {
+            radix4_butterfly(x, y, n, s, p, q, tw, tw_step);
+        }
+    }
+}
+
+void fft_radix2_q15(std::size_t n, std::size_t s, const q15_t* x, q15_t* y, const q15_t* tw,
+                    std::size_t tw_step) {
+    for (std::size_t p = 0; p < n / 2; ++p) {
+        for (std::size_t q = 0; q < s; ++q) {
+            radix2_butterfly(x, y, n, s, p, q, tw, tw_step);
+        }
+    }
+}
+
+}  // namespace
+
+const Kernels kScalar = {
+    fir_q15, fir_q31, biquad_q15, biquad_q31, moving_average_q15, fft_radix4_q15, fft_radix2_q15,
+};
+
+}  // namespace g7::dsp::detail
@@ -0,0 +1,353 @@
+// AVX2 kernels. Functions carry a target attribute instead of building the
+// file with -mavx2, so shared inline helpers are never emitted with AVX2
+// encodings and the library still runs on CPUs without it (Auto then falls
+// back to the scalar kernels).
+//
+// On Cortex-M the same data layouts map onto the CMSIS-DSP intrinsics: the
+// Q15 madd pairs are __SMLALD, the Q31 64-bit products are __SMLAL and the
+// saturating adds/subs are __QADD16/__QSUB16.
+
+#include "kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#include <cstring>
+
+#define G7_AVX2 __attribute__((target("avx2")))
+
+namespace g7::dsp::detail {
+namespace {
+
+G7_AVX2 inline q63_t hsum_epi64(__m256i v) {
+    const __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(_mm_add_epi64(s, _mm_unpackhi_epi64(s, s)));
+}
+
+// Widens eight 32-bit madd results and adds them to a 4 x int64 accumulator.
+G7_AVX2 inline __m256i acc_epi32(__m256i acc, __m256i m) {
+    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(m)));
+    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(m, 1)));
+}
+
+G7_AVX2 void fir_q15(const q15_t* c, std::size_t taps, const q15_t* x, q15_t* dst,
+                     std::size_t count, std::size_t stride) {
+    const std::size_t vec_taps = taps & ~std::size_t{15};
+    std::size_t i = 0;
+    // Four outputs per pass share each coefficient load.
+    for (; i + 4 <= count; i += 4) {
+        const q15_t* w0 = x + (i + 0) * stride;
+        const q15_t* w1 = x + (i + 1) * stride;
+        const q15_t* w2 = x + (i + 2) * stride;
+        const q15_t* w3 = x + (i + 3) * stride;
+        __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+        for (std::size_t k = 0; k < vec_taps; k += 16) {
+            const __m256i cv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + k));
+            a0 = acc_epi32(a0, _mm256_madd_epi16(cv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w0 + k))));
+            a1 = acc_epi32(a1, _mm256_madd_epi16(cv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w1 + k))));
+            a2 = acc_epi32(a2, _mm256_madd_epi16(cv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w2 + k))));
+            a3 = acc_epi32(a3, _mm256_madd_epi16(cv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w3 + k))));
+        }
+        q63_t s0 = hsum_epi64(a0), s1 = hsum_epi64(a1), s2 = hsum_epi64(a2), s3 = hsum_epi64(a3);
+        for (std::size_t k = vec_taps; k < taps; ++k) {
+            const std::int32_t ck = c[k];
+            s0 += ck * w0[k];
+            s1 += ck * w1[k];
+            s2 += ck * w2[k];
+            s3 += ck * w3[k];
+        }
+        dst[i + 0] = sat_q15(s0 >> 15);
+        dst[i + 1] = sat_q15(s1 >> 15);
+        dst[i + 2] = sat_q15(s2 >> 15);
+        dst[i + 3] = sat_q15(s3 >> 15);
+    }
+    for (; i < count; ++i) {
+        const q15_t* w = x + i * stride;
+        __m256i a = _mm256_setzero_si256();
+        for (std::size_t k = 0; k < vec_taps; k += 16) {
+            const __m256i cv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + k));
+            a = acc_epi32(a, _mm256_madd_epi16(cv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + k))));
+        }
+        q63_t s = hsum_epi64(a);
+        for (std::size_t k = vec_taps; k < taps; ++k) {
+            s += static_cast<std::int32_t>(c[k]) * w[k];
+        }
+        dst[i] = sat_q15(s >> 15);
+    }
+}
+
+// Full 64-bit products of eight int32 pairs, summed into four int64 lanes.
+G7_AVX2 inline __m256i mac_epi32x8(__m256i acc, __m256i a, __m256i b) {
+    acc = _mm256_add_epi64(acc, _mm256_mul_epi32(a, b));
+    return _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)));
+}
+
+G7_AVX2 void fir_q31(const q31_t* c, std::size_t taps, const q31_t* x, q31_t* dst,
+                     std::size_t count) {
+    const std::size_t vec_taps = taps & ~std::size_t{7};
+    for (std::size_t i = 0; i < count; ++i) {
+        const q31_t* w = x + i;
+        __m256i a = _mm256_setzero_si256();
+        for (std::size_t k = 0; k < vec_taps; k += 8) {
+            a = mac_epi32x8(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + k)),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + k)));
+        }
+        q63_t s = hsum_epi64(a);
+        for (std::size_t k = vec_taps; k < taps; ++k) {
+            s = add_wrap(s, static_cast<q63_t>(c[k]) * w[k]);
+        }
+        dst[i] = sat_q31(s >> 31);
+    }
+}
+
+constexpr std::size_t kChunk = 64;
+
+// Feed-forward terms for 16 samples: p01 = b0 x[n] + b1 x[n-1] (exact in
+// 32 bits while no coefficient is -1.0) and p2 = b2 x[n-2]. ext[0] is x[n-2].
+G7_AVX2 inline void biquad_ff_q15(const q15_t* ext, __m256i b01, __m256i b2z, std::int32_t* p01,
+                                  std::int32_t* p2) {
+    const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ext + 2));
+    const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ext + 1));
+    const __m256i x2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ext + 0));
+    const __m256i zero = _mm256_setzero_si256();
+    // unpacklo/hi interleave within 128-bit lanes: lo holds samples 0-3 and
+    // 8-11, hi holds 4-7 and 12-15; permute2x128 restores sample order.
+    const __m256i lo01 = _mm256_madd_epi16(_mm256_unpacklo_epi16(x0, x1), b01);
+    const __m256i hi01 = _mm256_madd_epi16(_mm256_unpackhi_epi16(x0, x1), b01);
+    const __m256i lo2 = _mm256_madd_epi16(_mm256_unpacklo_epi16(x2, zero), b2z);
+    const __m256i hi2 = _mm256_madd_epi16(_mm256_unpackhi_epi16(x2, zero), b2z);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p01), _mm256_permute2x128_si256(lo01, hi01, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p01 + 8), _mm256_permute2x128_si256(lo01, hi01, 0x31));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p2), _mm256_permute2x128_si256(lo2, hi2, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p2 + 8), _mm256_permute2x128_si256(lo2, hi2, 0x31));
+}
+
+G7_AVX2 void biquad_q15(const q15_t* c, q15_t* state, int shift, const q15_t* src, q15_t* dst,
+                        std::size_t n) {
+    const std::int32_t a1 = c[4], a2 = c[5];
+    const __m256i b01 = _mm256_set1_epi32(static_cast<std::int32_t>(
+        static_cast<std::uint16_t>(c[0]) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(c[2])) << 16)));
+    const __m256i b2z = _mm256_set1_epi32(static_cast<std::uint16_t>(c[3]));
+    q15_t ext[kChunk + 2];
+    alignas(32) std::int32_t p01[kChunk];
+    alignas(32) std::int32_t p2[kChunk];
+    ext[0] = state[1];
+    ext[1] = state[0];
+    q15_t y1 = state[2], y2 = state[3];
+    for (std::size_t done = 0; done < n;) {
+        const std::size_t len = n - done < kChunk ? n - done : kChunk;
+        std::memcpy(ext + 2, src + done, len * sizeof(q15_t));
+        std::size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            biquad_ff_q15(ext + i, b01, b2z, p01 + i, p2 + i);
+        }
+        for (; i < len; ++i) {
+            p01[i] = static_cast<std::int32_t>(static_cast<q63_t>(c[0] * ext[i + 2]) + c[2] * ext[i + 1]);
+            p2[i] = c[3] * ext[i];
+        }
+        for (i = 0; i < len; ++i) {
+            q63_t acc = static_cast<q63_t>(p01[i]) + p2[i];
+            acc += static_cast<q63_t>(a1 * y1) + a2 * y2;
+            y2 = y1;
+            y1 = sat_q15(acc >> (15 - shift));
+            dst[done + i] = y1;
+        }
+        ext[0] = ext[len];
+        ext[1] = ext[len + 1];
+        done += len;
+    }
+    state[0] = ext[1];
+    state[1] = ext[0];
+    state[2] = y1;
+    state[3] = y2;
+}
+
+G7_AVX2 void biquad_q31(const q31_t* c, q31_t* state, int shift, const q31_t* src, q31_t* dst,
+                        std::size_t n) {
+    const q63_t a1 = c[3], a2 = c[4];
+    const __m256i b0 = _mm256_set1_epi64x(c[0]);
+    const __m256i b1 = _mm256_set1_epi64x(c[1]);
+    const __m256i b2 = _mm256_set1_epi64x(c[2]);
+    q31_t ext[kChunk + 2];
+    alignas(32) q63_t ff[kChunk];
+    ext[0] = state[1];
+    ext[1] = state[0];
+    q31_t y1 = state[2], y2 = state[3];
+    for (std::size_t done = 0; done < n;) {
+        const std::size_t len = n - done < kChunk ? n - done : kChunk;
+        std::memcpy(ext + 2, src + done, len * sizeof(q31_t));
+        std::size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            const __m256i x0 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ext + i + 2)));
+            const __m256i x1 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ext + i + 1)));
+            const __m256i x2 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ext + i)));
+            __m256i acc = _mm256_mul_epi32(b0, x0);
+            acc = _mm256_add_epi64(acc, _mm256_mul_epi32(b1, x1));
+            acc = _mm256_add_epi64(acc, _mm256_mul_epi32(b2, x2));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(ff + i), acc);
+        }
+        for (; i < len; ++i) {
+            ff[i] = add_wrap(add_wrap(c[0] * static_cast<q63_t>(ext[i + 2]), c[1] * static_cast<q63_t>(ext[i + 1])),
+                             c[2] * static_cast<q63_t>(ext[i]));
+        }
+        for (i = 0; i < len; ++i) {
+            const q63_t acc = add_wrap(add_wrap(ff[i], a1 * y1), a2 * y2);
+            y2 = y1;
+            y1 = sat_q31(acc >> (31 - shift));
+            dst[done + i] = y1;
+        }
+        ext[0] = ext[len];
+        ext[1] = ext[len + 1];
+        done += len;
+    }
+    state[0] = ext[1];
+    state[1] = ext[0];
+    state[2] = y1;
+    state[3] = y2;
+}
+
+// Inclusive prefix sum of eight int32 lanes.
+G7_AVX2 inline __m256i scan_epi32(__m256i v) {
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+    const __m256i low_total = _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(3));
+    return _mm256_add_epi32(v, _mm256_blend_epi32(_mm256_setzero_si256(), low_total, 0xF0));
+}
+
+G7_AVX2 void moving_average_q15(const q15_t* x, std::size_t window, int shift, std::int32_t* sum,
+                                q15_t* dst, std::size_t n) {
+    const __m128i sh = _mm_cvtsi32_si128(shift);
+    __m256i carry = _mm256_set1_epi32(*sum);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i in = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + window)));
+        const __m256i out = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+        const __m256i s = _mm256_add_epi32(scan_epi32(_mm256_sub_epi32(in, out)), carry);
+        carry = _mm256_permutevar8x32_epi32(s, _mm256_set1_epi32(7));
+        const __m256i y = _mm256_packs_epi32(_mm256_sra_epi32(s, sh), _mm256_setzero_si256());
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_castsi256_si128(_mm256_permute4x64_epi64(y, 0x08)));
+    }
+    std::int32_t s = _mm256_cvtsi256_si32(carry);
+    for (; i < n; ++i) {
+        s += static_cast<std::int32_t>(x[i + window]) - x[i];
+        dst[i] = static_cast<q15_t>(s >> shift);
+    }
+    *sum = s;
+}
+
+// Butterflies below process eight complex points (one __m256i) at a time
+// along q, where the Stockham stride keeps them contiguous.
+
+G7_AVX2 inline __m256i load8(const q15_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+G7_AVX2 inline void store8(q15_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+G7_AVX2 inline __m256i broadcast_pair(const q15_t* p) {
+    std::int32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return _mm256_set1_epi32(v);
+}
+
+// Complex multiply by one twiddle entry, as cmul_tw() in kernels.hpp.
+G7_AVX2 inline __m256i cmul8(__m256i v, const q15_t* tw) {
+    const __m256i re = _mm256_mulhrs_epi16(v, broadcast_pair(tw));
+    const __m256i im = _mm256_mulhrs_epi16(v, broadcast_pair(tw + 2));
+    // hadds gives {re0..re3, im0..im3} per 128-bit lane; interleave back.
+    const __m256i h = _mm256_hadds_epi16(re, im);
+    const __m256i order = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+                                           0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+    return _mm256_shuffle_epi8(h, order);
+}
+
+// {x_im, x_re} per complex point.
+G7_AVX2 inline __m256i swap_re_im(__m256i v) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, 0xB1), 0xB1);
+}
+
+G7_AVX2 void fft_radix4_q15(std::size_t n, std::size_t s, const q15_t* x, q15_t* y,
+                            const q15_t* tw, std::size_t tw_step) {
+    const std::size_t m = n / 4;
+    if (s < 8) {
+        for (std::size_t p = 0; p < m; ++p) {
+            for (std::size_t q = 0; q < s; ++q) {
+                radix4_butterfly(x, y, n, s, p, q, tw, tw_step);
+            }
+        }
+        return;
+    }
+    for (std::size_t p = 0; p < m; ++p) {
+        const q15_t* w1 = tw + 4 * (1 * p * tw_step);
+        const q15_t* w2 = tw + 4 * (2 * p * tw_step);
+        const q15_t* w3 = tw + 4 * (3 * p * tw_step);
+        for (std::size_t q = 0; q < s; q += 8) {
+            const __m256i a = _mm256_srai_epi16(load8(x + 2 * (q + s * (p + 0 * m))), 2);
+            const __m256i b = _mm256_srai_epi16(load8(x + 2 * (q + s * (p + 1 * m))), 2);
+            const __m256i c = _mm256_srai_epi16(load8(x + 2 * (q + s * (p + 2 * m))), 2);
+            const __m256i d = _mm256_srai_epi16(load8(x + 2 * (q + s * (p + 3 * m))), 2);
+            const __m256i apc = _mm256_adds_epi16(a, c);
+            const __m256i amc = _mm256_subs_epi16(a, c);
+            const __m256i bpd = _mm256_adds_epi16(b, d);
+            const __m256i bmd = swap_re_im(_mm256_subs_epi16(b, d));
+            const __m256i plus = _mm256_adds_epi16(amc, bmd);
+            const __m256i minus = _mm256_subs_epi16(amc, bmd);
+            store8(y + 2 * (q + s * (4 * p + 0)), _mm256_adds_epi16(apc, bpd));
+            store8(y + 2 * (q + s * (4 * p + 1)), cmul8(_mm256_blend_epi16(plus, minus, 0xAA), w1));
+            store8(y + 2 * (q + s * (4 * p + 2)), cmul8(_mm256_subs_epi16(apc, bpd), w2));
+            store8(y + 2 * (q + s * (4 * p + 3)), cmul8(_mm256_blend_epi16(minus, plus, 0xAA), w3));
+        }
+    }
+}
+
+G7_AVX2 void fft_radix2_q15(std::size_t n, std::size_t s, const q15_t* x, q15_t* y,
+                            const q15_t* tw, std::size_t tw_step) {
+    const std::size_t m = n / 2;
+    if (s < 8) {
+        for (std::size_t p = 0; p < m; ++p) {
+            for (std::size_t q = 0; q < s; ++q) {
+                radix2_butterfly(x, y, n, s, p, q, tw, tw_step);
+            }
+        }
+        return;
+    }
+    for (std::size_t p = 0; p < m; ++p) {
+        const q15_t* w = tw + 4 * (p * tw_step);
+        for (std::size_t q = 0; q < s; q += 8) {
+            const __m256i a = _mm256_srai_epi16(load8(x + 2 * (q + s * p)), 1);
+            const __m256i b = _mm256_srai_epi16(load8(x + 2 * (q + s * (p + m))), 1);
+            store8(y + 2 * (q + s * (2 * p + 0)), _mm256_adds_epi16(a, b));
+            store8(y + 2 * (q + s * (2 * p + 1)), cmul8(_mm256_subs_epi16(a, b), w));
+        }
+    }
+}
+
+const Kernels kAvx2 = {
+    fir_q15, fir_q31, biquad_q15, biquad_q31, moving_average_q15, fft_radix4_q15, fft_radix2_q15,
+};
+
+}  // namespace
+
+const Kernels* simd_kernels() {
+    static const bool ok = __builtin_cpu_supports("avx2");
+    return ok ? &kAvx2 : nullptr;
+}
+
+const char* simd_kernels_name() { return "avx2"; }
+
+}  // namespace g7::dsp::detail
+
+#else
+
+namespace g7::dsp::detail {
+
+const Kernels* simd_kernels() { return nullptr; }
+const char* simd_kernels_name() { return "none"; }
+
+}  // namespace g7::dsp::detail
+
+#endif
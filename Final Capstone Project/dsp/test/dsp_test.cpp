@@ -0,0 +1,194 @@
+// Bit-exactness of the DSP kernels: every kernel runs through both paths on
+// random and full-scale inputs and the outputs are compared bit for bit.
+// Exits non-zero on any mismatch.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "g7/dsp.hpp"
+#include "signals.hpp"
+
+namespace dsp = g7::dsp;
+using dsp::Path;
+using dsp::q15_t;
+using dsp::q31_t;
+using namespace g7::dsp::test;
+
+namespace {
+
+int g_failures = 0;
+
+template <typename T>
+void expect_equal(const char* what, const std::vector<T>& a, const std::vector<T>& b) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) {
+            std::printf("MISMATCH %-32s at %zu: scalar=%lld simd=%lld\n", what, i,
+                        static_cast<long long>(a[i]), static_cast<long long>(b[i]));
+            ++g_failures;
+            return;
+        }
+    }
+    std::printf("ok       %s\n", what);
+}
+
+// Runs `run(path, out)` for both paths and compares the outputs.
+template <typename T, typename Run>
+void check(const char* what, std::size_t out_len, Run run) {
+    std::vector<T> ref(out_len), simd(out_len);
+    run(Path::Scalar, ref);
+    run(Path::Simd, simd);
+    expect_equal(what, ref, simd);
+}
+
+void verify_fir(std::size_t taps, bool full_scale) {
+    // Uneven chunk sizes exercise the state carry-over and the SIMD tails.
+    const std::size_t n = 1000;
+    const auto in = random_q15(n, 1 + static_cast<std::uint32_t>(taps), full_scale);
+    auto coeffs = full_scale ? random_q15(taps, 7, true) : lowpass_q15(taps, 0.1);
+    for (auto& c : coeffs) {
+        if (c == INT16_MIN) c = INT16_MAX;  // -1.0 would disable the SIMD path
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "fir_q15 taps=%zu%s", taps, full_scale ? " full" : "");
+    check<q15_t>(name, n, [&](Path p, std::vector<q15_t>& out) {
+        std::vector<q15_t> state(taps - 1 + kBlock);
+        dsp::FirQ15 f;
+        f.init(static_cast<std::uint16_t>(taps), coeffs.data(), state.data(), kBlock);
+        dsp::fir(f, in.data(), out.data(), 333, p);
+        dsp::fir(f, in.data() + 333, out.data() + 333, n - 333, p);
+    });
+}
+
+void verify_fir_q31(std::size_t taps, bool full_scale) {
+    const std::size_t n = 1000;
+    const auto in = random_q31(n, 3 + static_cast<std::uint32_t>(taps), full_scale);
+    const auto coeffs = random_q31(taps, 11, full_scale);
+    char name[64];
+    std::snprintf(name, sizeof(name), "fir_q31 taps=%zu%s", taps, full_scale ? " full" : "");
+    check<q31_t>(name, n, [&](Path p, std::vector<q31_t>& out) {
+        std::vector<q31_t> state(taps - 1 + kBlock);
+        dsp::FirQ31 f;
+        f.init(static_cast<std::uint16_t>(taps), coeffs.data(), state.data(), kBlock);
+        dsp::fir(f, in.data(), out.data(), 100, p);
+        dsp::fir(f, in.data() + 100, out.data() + 100, n - 100, p);
+    });
+}
+
+void verify_decimate(std::size_t taps, std::uint8_t factor) {
+    const std::size_t n = 1024;
+    const auto in = random_q15(n, 5);
+    const auto coeffs = lowpass_q15(taps, 0.5 / factor);
+    char name[64];
+    std::snprintf(name, sizeof(name), "fir_decimate_q15 taps=%zu M=%u", taps, factor);
+    check<q15_t>(name, n / factor, [&](Path p, std::vector<q15_t>& out) {
+        std::vector<q15_t> state(taps - 1 + kBlock);
+        dsp::FirDecimateQ15 f;
+        f.init(static_cast<std::uint16_t>(taps), factor, coeffs.data(), state.data(), kBlock);
+        dsp::fir_decimate(f, in.data(), out.data(), n, p);
+    });
+}
+
+void verify_biquad(bool full_scale) {
+    const std::size_t n = 1003;
+    const auto in = random_q15(n, 9, full_scale);
+    const auto in31 = random_q31(n, 10, full_scale);
+    q15_t c15[12];
+    q31_t c31[10];
+    for (int s = 0; s < 2; ++s) {
+        std::memcpy(c15 + 6 * s, kBiquadQ15, sizeof(kBiquadQ15));
+        std::memcpy(c31 + 5 * s, kBiquadQ31, sizeof(kBiquadQ31));
+    }
+    check<q15_t>(full_scale ? "biquad_q15 x2 full" : "biquad_q15 x2", n,
+                 [&](Path p, std::vector<q15_t>& out) {
+        q15_t state[8];
+        dsp::BiquadQ15 f;
+        f.init(2, c15, state, 1);
+        dsp::biquad(f, in.data(), out.data(), 500, p);
+        dsp::biquad(f, in.data() + 500, out.data() + 500, n - 500, p);
+    });
+    check<q31_t>(full_scale ? "biquad_q31 x2 full" : "biquad_q31 x2", n,
+                 [&](Path p, std::vector<q31_t>& out) {
+        q31_t state[8];
+        dsp::BiquadQ31 f;
+        f.init(2, c31, state, 1);
+        dsp::biquad(f, in31.data(), out.data(), 500, p);
+        dsp::biquad(f, in31.data() + 500, out.data() + 500, n - 500, p);
+    });
+}
+
+void verify_moving_average(std::uint16_t window, bool full_scale) {
+    const std::size_t n = 1001;
+    const auto in = random_q15(n, 13, full_scale);
+    char name[64];
+    std::snprintf(name, sizeof(name), "moving_average_q15 W=%u%s", window, full_scale ? " full" : "");
+    check<q15_t>(name, n, [&](Path p, std::vector<q15_t>& out) {
+        std::vector<q15_t> state(window + kBlock);
+        dsp::MovingAverageQ15 f;
+        f.init(window, state.data(), kBlock);
+        dsp::moving_average(f, in.data(), out.data(), n, p);
+    });
+}
+
+void verify_fft(std::uint32_t len, bool full_scale) {
+    const auto in = random_q15(2 * len, 17 + len, full_scale);
+    std::vector<q15_t> tw(4 * len);
+    dsp::CfftQ15 f;
+    f.init(len, tw.data());
+    char name[64];
+    std::snprintf(name, sizeof(name), "cfft_q15 N=%u%s", len, full_scale ? " full" : "");
+    std::vector<q15_t> ref;
+    check<q15_t>(name, 2 * len, [&](Path p, std::vector<q15_t>& out) {
+        std::vector<q15_t> scratch(2 * len);
+        out = in;
+        dsp::cfft(f, out.data(), scratch.data(), p);
+        if (p == Path::Scalar) ref = out;
+    });
+    if (full_scale) {
+        return;
+    }
+    // Sanity-check the algorithm itself against a double-precision DFT / N.
+    double max_err = 0.0;
+    for (std::uint32_t k = 0; k < len; ++k) {
+        std::complex<double> acc = 0.0;
+        for (std::uint32_t t = 0; t < len; ++t) {
+            const double ang = -2.0 * M_PI * static_cast<double>((static_cast<std::uint64_t>(k) * t) % len) / len;
+            acc += std::complex<double>(in[2 * t], in[2 * t + 1]) * std::polar(1.0, ang);
+        }
+        acc /= static_cast<double>(len);
+        max_err = std::max(max_err, std::abs(acc - std::complex<double>(ref[2 * k], ref[2 * k + 1])));
+    }
+    // Each stage's pre-scale truncates up to one LSB per component.
+    const double bound = 2.0 * f.log2_length + 4.0;
+    if (max_err > bound) {
+        std::printf("MISMATCH cfft_q15 N=%u vs DFT: max error %.2f LSB > %.2f\n", len, max_err, bound);
+        ++g_failures;
+    } else {
+        std::printf("ok       cfft_q15 N=%u vs DFT (max error %.2f LSB)\n", len, max_err);
+    }
+}
+
+int verify() {
+    std::printf("SIMD path: %s\n", dsp::simd_name());
+    if (!dsp::simd_available()) {
+        std::printf("no SIMD kernels on this CPU; nothing to compare\n");
+        return 0;
+    }
+    for (bool full : {false, true}) {
+        for (std::size_t taps : {1, 5, 16, 29, 32, 64}) verify_fir(taps, full);
+        for (std::size_t taps : {3, 8, 31}) verify_fir_q31(taps, full);
+        verify_biquad(full);
+        for (std::uint16_t w : {1, 8, 64, 512}) verify_moving_average(w, full);
+        for (std::uint32_t len : {4u, 8u, 16u, 32u, 64u, 128u, 256u, 1024u}) verify_fft(len, full);
+    }
+    for (std::uint8_t m : {2, 4, 8}) verify_decimate(32, m);
+    std::printf("%s: %d mismatches\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
+
+}  // namespace
+
+int main() { return verify(); }
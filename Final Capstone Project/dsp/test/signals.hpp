@@ -0,0 +1,47 @@
+// Test signals shared by the DSP tests and benchmarks.
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "g7/dsp.hpp"
+
+namespace g7::dsp::test {
+
+inline constexpr std::size_t kBlock = 256;
+
+inline std::vector<q15_t> random_q15(std::size_t n, std::uint32_t seed, bool full_scale = false) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(INT16_MIN, INT16_MAX);
+    std::vector<q15_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        // Full-scale runs alternate the extremes to hit every saturation edge.
+        v[i] = full_scale ? static_cast<q15_t>((rng() & 1) ? INT16_MAX : INT16_MIN)
+                          : static_cast<q15_t>(dist(rng));
+    }
+    return v;
+}
+
+inline std::vector<q31_t> random_q31(std::size_t n, std::uint32_t seed, bool full_scale = false) {
+    std::mt19937 rng(seed);
+    std::vector<q31_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = full_scale ? ((rng() & 1) ? INT32_MAX : INT32_MIN) : static_cast<q31_t>(rng());
+    }
+    return v;
+}
+
+// fir_lowpass_q15() coefficients, ready for init().
+inline std::vector<q15_t> lowpass_q15(std::size_t taps, double cutoff) {
+    std::vector<q15_t> c(taps);
+    fir_lowpass_q15(c.data(), taps, cutoff);
+    return c;
+}
+
+// 2nd-order Butterworth low-pass at fs/8 in CMSIS Q15 layout, post_shift 1.
+inline constexpr q15_t kBiquadQ15[6] = {1596, 0, 3192, 1596, 14861, -5631};
+// The same section in Q31 with post_shift 1.
+inline constexpr q31_t kBiquadQ31[5] = {104595776, 209191552, 104595776, 973926656, -369016832};
+
+}  // namespace g7::dsp::test
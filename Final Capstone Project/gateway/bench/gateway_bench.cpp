@@ -0,0 +1,181 @@
+// Gateway fusion benchmarks on the 10k-node load.
+//
+//   ./g7_gateway_bench --benchmark_counters_tabular=true
+//
+// The load generator is in test/load.hpp. That the SIMD, scalar and
+// multi-threaded paths agree and track the generator is checked by
+// g7_gateway_test.
+//
+// Counters:
+//   ns/update      per-node update cost, for the SoA kernels and the
+//                  array-of-structs baseline
+//   updates/s      reports fused per second of wall time, including push()
+//   step_p50_us, step_p99_us
+//                  one frame's latency, from the last push() to step() return
+//   steals/step    ranges stolen per frame
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "g7/cycles.hpp"
+#include "g7/gateway.hpp"
+#include "g7/histogram.hpp"
+#include "load.hpp"
+
+using namespace g7::gateway::test;
+
+namespace {
+
+// Array-of-structs baseline: the same filters, one struct per node.
+struct NodeAoS {
+    float pitch, roll, level, rate, p00, p01, p11;
+    std::uint32_t t_last, updates, rejected;
+};
+
+void fuse_aos(std::vector<NodeAoS>& nodes, const std::vector<Report>& reports, const gw::FusionConfig& c) {
+    for (const Report& rep : reports) {
+        NodeAoS& n = nodes[rep.node];
+        const gw::Sample& s = rep.s;
+        const float pa = gw::fast_atan2(-s.ax, std::sqrt(s.ay * s.ay + s.az * s.az));
+        const float ra = gw::fast_atan2(s.ay, s.az);
+        if (n.updates == 0) {
+            n = {pa, ra, s.value, 0.0f, c.r, 0.0f, c.rate_var0, s.t_ms, 0, 0};
+        } else {
+            const auto elapsed = static_cast<std::int32_t>(s.t_ms - n.t_last);
+            const float dt = std::min(std::max(static_cast<float>(elapsed) * 0.001f, 0.0f), c.dt_max);
+            n.pitch = c.alpha * (n.pitch + s.gy * dt) + (1.0f - c.alpha) * pa;
+            n.roll = c.alpha * (n.roll + s.gx * dt) + (1.0f - c.alpha) * ra;
+            const float xp = n.level + n.rate * dt;
+            const float p00p = n.p00 + dt * (n.p01 + n.p01 + dt * n.p11) + c.q_value * dt;
+            const float p01p = n.p01 + dt * n.p11;
+            const float p11p = n.p11 + c.q_rate * dt;
+            const float y = s.value - xp;
+            const float sv = p00p + c.r;
+            if (c.gate > 0.0f && y * y > c.gate * sv) {
+                n.level = xp;
+                n.p00 = p00p;
+                n.p01 = p01p;
+                n.p11 = p11p;
+                ++n.rejected;
+            } else {
+                const float k0 = p00p / sv, k1 = p01p / sv;
+                n.level = xp + k0 * y;
+                n.rate = n.rate + k1 * y;
+                n.p00 = (1.0f - k0) * p00p;
+                n.p01 = (1.0f - k0) * p01p;
+                n.p11 = p11p - k1 * p01p;
+            }
+        }
+        n.t_last = s.t_ms;
+        ++n.updates;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Fusion kernels: one frame, each node's latest report
+
+void BM_Fuse(benchmark::State& state) {
+    const auto path = state.range(0) ? gw::Path::Simd : gw::Path::Scalar;
+    if (path == gw::Path::Simd && !gw::simd_available()) {
+        state.SkipWithError("no SIMD path on this CPU");
+        return;
+    }
+    gw::FusionState s(kNodes);
+    gw::SampleBatch in(kNodes);
+    const Load& l = load();
+    std::size_t frame = 0;
+    std::uint64_t updates = 0;
+    const gw::FusionConfig cfg;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::fill(in.valid.begin(), in.valid.end(), std::uint8_t{0});
+        for (const Report& r : l.frames[frame]) in.set(r.node, r.s);
+        updates += static_cast<std::uint64_t>(std::count(in.valid.begin(), in.valid.end(), std::uint8_t{1}));
+        frame = (frame + 1) % kFrames;
+        state.ResumeTiming();
+        gw::fuse(s, in, 0, kNodes, cfg, path);
+    }
+    state.SetLabel(path == gw::Path::Simd ? gw::simd_name() : "scalar");
+    state.counters["ns/update"] =
+        benchmark::Counter(static_cast<double>(updates), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Fuse)->ArgNames({"simd"})->Arg(0)->Arg(1);
+
+void BM_FuseAoS(benchmark::State& state) {
+    std::vector<NodeAoS> nodes(kNodes, NodeAoS{});
+    const Load& l = load();
+    const gw::FusionConfig cfg;
+    std::size_t frame = 0;
+    std::uint64_t updates = 0;
+    for (auto _ : state) {
+        fuse_aos(nodes, l.frames[frame], cfg);
+        updates += l.frames[frame].size();
+        frame = (frame + 1) % kFrames;
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel("array of structs, scalar");
+    state.counters["ns/update"] =
+        benchmark::Counter(static_cast<double>(updates), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_FuseAoS);
+
+// ---------------------------------------------------------------------------
+// Load generator: kNodes nodes through the engine on range(0) threads
+
+void BM_Gateway(benchmark::State& state) {
+    const unsigned threads = static_cast<unsigned>(state.range(0));
+    gw::ThreadPool pool(threads);
+    gw::Engine engine(pool, config(gw::Path::Auto));
+    const Load& l = load();
+    g7::Histogram latency;
+    std::size_t frame = 0;
+    std::uint64_t fused = 0;
+    pool.reset_stats();
+    for (auto _ : state) {
+        for (const Report& r : l.frames[frame]) engine.push(r.node, r.s);
+        const std::uint64_t t0 = g7::cycles::now();
+        fused += engine.step();
+        latency.add(static_cast<std::uint64_t>(g7::cycles::to_ns(g7::cycles::now() - t0)));
+        frame = (frame + 1) % kFrames;
+    }
+    const double steps = static_cast<double>(state.iterations());
+    state.counters["updates/s"] = benchmark::Counter(static_cast<double>(fused), benchmark::Counter::kIsRate);
+    state.counters["step_p50_us"] = static_cast<double>(latency.percentile(50)) / 1e3;
+    state.counters["step_p99_us"] = static_cast<double>(latency.percentile(99)) / 1e3;
+    state.counters["steals/step"] = static_cast<double>(pool.total_stats().steals) / steps;
+}
+
+void thread_counts(benchmark::internal::Benchmark* b) {
+    // At least up to 4, so small hosts still show the oversubscribed case.
+    const unsigned top = std::max(4u, std::thread::hardware_concurrency());
+    for (unsigned t = 1; t < top; t *= 2) b->Arg(t);
+    b->Arg(top);
+}
+BENCHMARK(BM_Gateway)->ArgNames({"threads"})->Apply(thread_counts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Fork-join overhead: an empty loop over the blocks of a 10k-node frame.
+void BM_PoolDispatch(benchmark::State& state) {
+    gw::ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    for (auto _ : state) {
+        pool.parallel_for(kNodes / 512 + 1, 1, [](std::size_t b, std::size_t e) { benchmark::DoNotOptimize(b + e); });
+    }
+    state.counters["ns/loop"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                   benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_PoolDispatch)->ArgNames({"threads"})->Apply(thread_counts)->UseRealTime();
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,6 @@
+// Umbrella header for the gateway fusion engine.
+#pragma once
+
+#include "g7/gateway/engine.hpp"
+#include "g7/gateway/fusion.hpp"
+#include "g7/gateway/thread_pool.hpp"
@@ -0,0 +1,86 @@
+// Gateway fusion engine: collects reports from many nodes and fuses them in
+// parallel.
+//
+//   g7::gateway::ThreadPool pool;
+//   g7::gateway::Engine engine(pool, {.nodes = 10000});
+//   decoder callback:  engine.ingest(record);       // or engine.push(node, sample)
+//   every frame:       engine.step();
+//   engine.state().pitch[node], .level[node], ...
+//
+// push() stages a report in row k of a SampleBatch stack, where k is how
+// many reports that node already has waiting. Up to `depth` fit; more are
+// dropped and counted. step() cuts the nodes into blocks of `block`,
+// multiples of 8 so SIMD groups never straddle two tasks. The blocks run on
+// the pool, each fusing its rows oldest first. Work per block follows the
+// traffic of its nodes, which is uneven, and work stealing evens it out.
+//
+// push() and ingest() come from one thread and never run during step().
+// Nodes are independent, so the result does not depend on the thread count.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "g7/gateway/fusion.hpp"
+#include "g7/gateway/thread_pool.hpp"
+#include "g7/telemetry/decoder.hpp"
+#include "g7/telemetry/schema.hpp"
+
+namespace g7::gateway {
+
+// Node report on the wire: milli-g, milli-rad/s and milli-units.
+inline constexpr telemetry::Schema<7> kSampleSchema{
+    0x20, "fusion",
+    {{telemetry::varint("node"), telemetry::zigzag("ax_mg"), telemetry::zigzag("ay_mg"), telemetry::zigzag("az_mg"),
+      telemetry::zigzag("gx_mrad_s"), telemetry::zigzag("gy_mrad_s"), telemetry::zigzag("value_milli")}}};
+static_assert(kSampleSchema.valid());
+
+struct EngineConfig {
+    std::size_t nodes = 0;
+    std::size_t block = 512;  // nodes per pool task, rounded up to a multiple of 8
+    std::size_t depth = 4;    // reports a node may queue between steps, 1..255
+    FusionConfig fusion;
+    Path path = Path::Auto;
+};
+
+struct EngineStats {
+    std::uint64_t steps = 0;
+    std::uint64_t fused = 0;
+    std::uint64_t dropped = 0;  // queue full or node out of range
+    std::uint64_t rejected = 0; // Kalman gate, summed over nodes
+};
+
+class Engine {
+public:
+    Engine(ThreadPool& pool, const EngineConfig& cfg);
+
+    // Stages one report. False if the node is unknown or its queue is full.
+    bool push(std::uint32_t node, const Sample& s);
+    // push() for a kSampleSchema record. False for other schemas too.
+    bool ingest(const telemetry::Record& r);
+
+    // Fuses everything staged so far. Returns the number of reports fused.
+    std::size_t step();
+
+    const FusionState& state() const { return state_; }
+    const EngineConfig& config() const { return cfg_; }
+    std::size_t pending() const { return pending_; }
+    EngineStats stats() const;
+
+private:
+    void fuse_block(std::size_t block);
+
+    ThreadPool& pool_;
+    EngineConfig cfg_;
+    FusionState state_;
+    std::vector<SampleBatch> rows_;
+    std::vector<std::uint8_t> queued_;
+    std::size_t pending_ = 0;
+    EngineStats stats_;
+};
+
+// Decodes a kSampleSchema record. False for any other schema.
+bool to_sample(const telemetry::Record& r, std::uint32_t& node, Sample& s);
+
+}  // namespace g7::gateway
@@ -0,0 +1,85 @@
+// Per-node sensor fusion in structure-of-arrays form.
+//
+// Every node carries two filters:
+//
+//   tilt   complementary filter: pitch and roll from the accelerometer,
+//          smoothed with the integrated gyro rates
+//   value  2-state (level, rate) constant-velocity Kalman filter over one
+//          scalar channel, with an innovation gate that rejects outliers
+//
+// FusionState keeps each state variable in its own array, so a batch update
+// streams through memory and the SIMD path handles 8 nodes per instruction.
+// Both paths evaluate the same float operations in the same order (no FMA,
+// the same atan2 polynomial), so they are bit-exact, like the DSP kernels.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace g7::gateway {
+
+// Selects the fusion kernel. Auto picks Simd when the CPU supports it.
+enum class Path { Auto, Scalar, Simd };
+
+// True when the SIMD kernel was compiled in and the running CPU supports it.
+bool simd_available();
+// "avx2" or "none".
+const char* simd_name();
+
+// One report from a node.
+struct Sample {
+    std::uint32_t t_ms = 0;    // node clock
+    float ax = 0, ay = 0, az = 0;  // acceleration, g
+    float gx = 0, gy = 0;      // roll and pitch rates, rad/s
+    float value = 0;           // scalar channel, e.g. temperature
+};
+
+struct FusionConfig {
+    float alpha = 0.98f;      // weight of the gyro path in the tilt filter
+    float q_value = 1e-3f;    // Kalman process noise per second, level
+    float q_rate = 1e-4f;     // the same, rate
+    float r = 0.05f;          // measurement noise variance
+    float rate_var0 = 1.0f;   // initial rate variance
+    float gate = 16.0f;       // reject when innovation^2 > gate * S; 0 disables
+    float dt_max = 1.0f;      // longer gaps are clamped, seconds
+};
+
+// Fusion input for many nodes at once: slot i belongs to node i and is only
+// used when valid[i] is non-zero.
+struct SampleBatch {
+    explicit SampleBatch(std::size_t nodes = 0) { resize(nodes); }
+    void resize(std::size_t nodes);
+    void set(std::size_t i, const Sample& s);
+
+    std::vector<std::uint32_t> t_ms;
+    std::vector<float> ax, ay, az, gx, gy, value;
+    std::vector<std::uint8_t> valid;
+};
+
+class FusionState {
+public:
+    explicit FusionState(std::size_t nodes);
+
+    std::size_t size() const { return pitch.size(); }
+
+    // Filter outputs, radians and channel units.
+    std::vector<float> pitch, roll;
+    std::vector<float> level, rate;
+    // Kalman covariance, symmetric: p00, p01 (= p10), p11.
+    std::vector<float> p00, p01, p11;
+    std::vector<std::uint32_t> t_last;
+    std::vector<std::uint32_t> updates;   // samples fused; 0 until the first one
+    std::vector<std::uint32_t> rejected;  // samples the Kalman gate turned away
+};
+
+// Fuses the valid slots of `in` for nodes [begin, end) into `s`. A node's
+// first sample initialises its filters. The SIMD path handles groups of 8
+// nodes from `begin` and the scalar kernel takes the rest.
+void fuse(FusionState& s, const SampleBatch& in, std::size_t begin, std::size_t end,
+          const FusionConfig& cfg, Path path = Path::Auto);
+
+// Branch-free atan2 polynomial shared by both paths, max error ~1e-5 rad.
+float fast_atan2(float y, float x);
+
+}  // namespace g7::gateway
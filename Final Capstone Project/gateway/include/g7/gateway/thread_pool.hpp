@@ -0,0 +1,89 @@
+// Work-stealing thread pool for the gateway's fork-join loops.
+//
+//   g7::gateway::ThreadPool pool(4);  // the calling thread plus 3 workers
+//   pool.parallel_for(blocks, 1, [&](std::size_t begin, std::size_t end) { ... });
+//
+// parallel_for() splits [0, n) lazily. A worker holding more than `grain`
+// items pushes the upper half of its range onto its own deque and carries on
+// with the lower half. Idle workers steal from the top of a random victim's
+// deque, where the largest ranges sit, so uneven work spreads out without a
+// shared queue. Owners push and pop at the bottom without locks or RMWs in
+// the common case (Chase-Lev).
+//
+// Halving bounds a deque at one entry per level, so each is a fixed array of
+// kDequeSlots ranges. Nothing allocates after construction. Idle workers
+// sleep on an atomic wait and cost nothing between loops.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace g7::gateway {
+
+struct WorkerStats {
+    std::uint64_t chunks = 0;  // body calls
+    std::uint64_t items = 0;
+    std::uint64_t steals = 0;  // ranges taken from another worker
+};
+
+class ThreadPool {
+public:
+    static constexpr std::size_t kDequeSlots = 64;
+
+    // `threads` counts the caller of parallel_for(), which takes part in
+    // every loop; 0 means one per hardware thread.
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    // Calls body(begin, end) over disjoint chunks of at most `grain` items
+    // covering [0, n) and returns when all are done. Not reentrant: body
+    // must not call parallel_for() on the same pool.
+    template <class F>
+    void parallel_for(std::size_t n, std::size_t grain, F&& body) {
+        // F is Lambda& for lvalues and may be const; the trampoline casts
+        // back to exactly that type, so the const_cast is never written through.
+        using Fn = std::remove_reference_t<F>;
+        run(n, grain, [](void* ctx, std::size_t b, std::size_t e) { (*static_cast<Fn*>(ctx))(b, e); },
+            const_cast<void*>(static_cast<const void*>(std::addressof(body))));
+    }
+
+    // Worker 0 is the calling thread. Read between loops.
+    WorkerStats stats(unsigned worker) const;
+    WorkerStats total_stats() const;
+    void reset_stats();
+
+private:
+    struct Worker;
+    using Body = void (*)(void*, std::size_t, std::size_t);
+
+    void run(std::size_t n, std::size_t grain, Body body, void* ctx);
+    void work(unsigned id);
+    void execute(Worker& w, std::uint64_t range);
+    bool steal(unsigned id, std::uint64_t& range);
+    void loop(unsigned id);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Current loop; written before any of its ranges is published.
+    Body body_ = nullptr;
+    void* ctx_ = nullptr;
+    std::size_t grain_ = 1;
+    std::size_t offset_ = 0;
+    std::atomic<std::size_t> remaining_{0};
+
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<unsigned> busy_{0};
+    std::atomic<bool> quit_{false};
+};
+
+}  // namespace g7::gateway
@@ -0,0 +1,85 @@
+// Report staging and the parallel fusion step.
+
+#include "g7/gateway/engine.hpp"
+
+#include <algorithm>
+
+namespace g7::gateway {
+
+Engine::Engine(ThreadPool& pool, const EngineConfig& cfg)
+    : pool_(pool), cfg_(cfg), state_(cfg.nodes), queued_(cfg.nodes, 0) {
+    cfg_.block = std::max<std::size_t>(8, (cfg_.block + 7) & ~std::size_t{7});
+    cfg_.depth = std::clamp<std::size_t>(cfg_.depth, 1, 255);
+    rows_.reserve(cfg_.depth);
+    for (std::size_t k = 0; k < cfg_.depth; ++k) rows_.emplace_back(cfg_.nodes);
+}
+
+bool Engine::push(std::uint32_t node, const Sample& s) {
+    if (node >= cfg_.nodes || queued_[node] == cfg_.depth) {
+        ++stats_.dropped;
+        return false;
+    }
+    rows_[queued_[node]++].set(node, s);
+    ++pending_;
+    return true;
+}
+
+bool to_sample(const telemetry::Record& r, std::uint32_t& node, Sample& s) {
+    if (r.schema == nullptr || r.schema->id != kSampleSchema.id) return false;
+    constexpr float kMilli = 0.001f;
+    node = static_cast<std::uint32_t>(r.values[0]);
+    s.t_ms = r.timestamp;
+    s.ax = static_cast<float>(r.values[1]) * kMilli;
+    s.ay = static_cast<float>(r.values[2]) * kMilli;
+    s.az = static_cast<float>(r.values[3]) * kMilli;
+    s.gx = static_cast<float>(r.values[4]) * kMilli;
+    s.gy = static_cast<float>(r.values[5]) * kMilli;
+    s.value = static_cast<float>(r.values[6]) * kMilli;
+    return true;
+}
+
+bool Engine::ingest(const telemetry::Record& r) {
+    std::uint32_t node = 0;
+    Sample s;
+    if (!to_sample(r, node, s)) {
+        ++stats_.dropped;
+        return false;
+    }
+    return push(node, s);
+}
+
+void Engine::fuse_block(std::size_t block) {
+    const std::size_t begin = block * cfg_.block;
+    const std::size_t end = std::min(cfg_.nodes, begin + cfg_.block);
+    const std::uint8_t depth = *std::max_element(queued_.begin() + static_cast<std::ptrdiff_t>(begin),
+                                                 queued_.begin() + static_cast<std::ptrdiff_t>(end));
+    for (std::size_t k = 0; k < depth; ++k) {
+        SampleBatch& row = rows_[k];
+        fuse(state_, row, begin, end, cfg_.fusion, cfg_.path);
+        std::fill(row.valid.begin() + static_cast<std::ptrdiff_t>(begin),
+                  row.valid.begin() + static_cast<std::ptrdiff_t>(end), std::uint8_t{0});
+    }
+    std::fill(queued_.begin() + static_cast<std::ptrdiff_t>(begin), queued_.begin() + static_cast<std::ptrdiff_t>(end),
+              std::uint8_t{0});
+}
+
+std::size_t Engine::step() {
+    const std::size_t fused = pending_;
+    if (fused == 0) return 0;
+    const std::size_t blocks = (cfg_.nodes + cfg_.block - 1) / cfg_.block;
+    pool_.parallel_for(blocks, 1, [this](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) fuse_block(i);
+    });
+    pending_ = 0;
+    ++stats_.steps;
+    stats_.fused += fused;
+    return fused;
+}
+
+EngineStats Engine::stats() const {
+    EngineStats s = stats_;
+    for (std::uint32_t r : state_.rejected) s.rejected += r;
+    return s;
+}
+
+}  // namespace g7::gateway
@@ -0,0 +1,123 @@
+// Fusion state, the scalar reference kernel and path selection.
+//
+// The expressions below fix the evaluation order the AVX2 kernel mirrors;
+// regrouping any of them breaks the bit-exact match between the paths.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "fusion_kernels.hpp"
+
+namespace g7::gateway {
+
+void SampleBatch::resize(std::size_t nodes) {
+    t_ms.assign(nodes, 0);
+    for (std::vector<float>* v : {&ax, &ay, &az, &gx, &gy, &value}) v->assign(nodes, 0.0f);
+    valid.assign(nodes, 0);
+}
+
+void SampleBatch::set(std::size_t i, const Sample& s) {
+    t_ms[i] = s.t_ms;
+    ax[i] = s.ax;
+    ay[i] = s.ay;
+    az[i] = s.az;
+    gx[i] = s.gx;
+    gy[i] = s.gy;
+    value[i] = s.value;
+    valid[i] = 1;
+}
+
+FusionState::FusionState(std::size_t nodes)
+    : pitch(nodes), roll(nodes), level(nodes), rate(nodes), p00(nodes), p01(nodes), p11(nodes),
+      t_last(nodes), updates(nodes), rejected(nodes) {}
+
+float fast_atan2(float y, float x) {
+    using namespace detail;
+    const float ax = std::fabs(x);
+    const float ay = std::fabs(y);
+    const float a = std::min(ax, ay) / std::max(std::max(ax, ay), kTiny);
+    const float s = a * a;
+    float p = kAtan[4];
+    p = p * s + kAtan[3];
+    p = p * s + kAtan[2];
+    p = p * s + kAtan[1];
+    p = p * s + kAtan[0];
+    float r = p * a;
+    if (ay > ax) r = kHalfPi - r;
+    if (x < 0.0f) r = kPi - r;
+    if (y < 0.0f) r = -r;
+    return r;
+}
+
+namespace detail {
+
+void fuse_scalar(FusionState& s, const SampleBatch& in, std::size_t begin, std::size_t end,
+                 const FusionConfig& c) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (in.valid[i] == 0) continue;
+        const float z = in.value[i];
+        const float pa = fast_atan2(-in.ax[i], std::sqrt(in.ay[i] * in.ay[i] + in.az[i] * in.az[i]));
+        const float ra = fast_atan2(in.ay[i], in.az[i]);
+
+        if (s.updates[i] == 0) {
+            s.pitch[i] = pa;
+            s.roll[i] = ra;
+            s.level[i] = z;
+            s.rate[i] = 0.0f;
+            s.p00[i] = c.r;
+            s.p01[i] = 0.0f;
+            s.p11[i] = c.rate_var0;
+        } else {
+            // Wrap-safe: the node clock is a free-running 32-bit ms counter.
+            const auto elapsed = static_cast<std::int32_t>(in.t_ms[i] - s.t_last[i]);
+            const float dt = std::min(std::max(static_cast<float>(elapsed) * kMsToS, 0.0f), c.dt_max);
+            const float oma = 1.0f - c.alpha;
+            s.pitch[i] = c.alpha * (s.pitch[i] + in.gy[i] * dt) + oma * pa;
+            s.roll[i] = c.alpha * (s.roll[i] + in.gx[i] * dt) + oma * ra;
+
+            // Predict with F = [1 dt; 0 1], then update with H = [1 0].
+            const float p01 = s.p01[i];
+            const float p11 = s.p11[i];
+            const float xp = s.level[i] + s.rate[i] * dt;
+            const float p00p = s.p00[i] + dt * (p01 + p01 + dt * p11) + c.q_value * dt;
+            const float p01p = p01 + dt * p11;
+            const float p11p = p11 + c.q_rate * dt;
+            const float y = z - xp;
+            const float sv = p00p + c.r;
+            if (c.gate > 0.0f && y * y > c.gate * sv) {
+                s.level[i] = xp;
+                s.p00[i] = p00p;
+                s.p01[i] = p01p;
+                s.p11[i] = p11p;
+                ++s.rejected[i];
+            } else {
+                const float k0 = p00p / sv;
+                const float k1 = p01p / sv;
+                s.level[i] = xp + k0 * y;
+                s.rate[i] = s.rate[i] + k1 * y;
+                s.p00[i] = (1.0f - k0) * p00p;
+                s.p01[i] = (1.0f - k0) * p01p;
+                s.p11[i] = p11p - k1 * p01p;
+            }
+        }
+        s.t_last[i] = in.t_ms[i];
+        ++s.updates[i];
+    }
+}
+
+}  // namespace detail
+
+bool simd_available() { return detail::simd_fuse() != nullptr; }
+
+const char* simd_name() { return simd_available() ? detail::simd_fuse_name() : "none"; }
+
+void fuse(FusionState& s, const SampleBatch& in, std::size_t begin, std::size_t end, const FusionConfig& cfg,
+          Path path) {
+    if (path != Path::Scalar) {
+        if (const detail::SimdFuse k = detail::simd_fuse()) begin = k(s, in, begin, end, cfg);
+    }
+    detail::fuse_scalar(s, in, begin, end, cfg);
+}
+
+}  // namespace g7::gateway
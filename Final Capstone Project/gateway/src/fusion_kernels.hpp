@@ -0,0 +1,30 @@
+// Fusion kernels behind g7::gateway::fuse(). fusion.cpp owns the scalar
+// reference and path selection; fusion_x86.cpp has the AVX2 kernel.
+#pragma once
+
+#include <cstddef>
+
+#include "g7/gateway/fusion.hpp"
+
+namespace g7::gateway::detail {
+
+// atan(a) on [0, 1] as an odd polynomial in a, Horner order from kAtan[4].
+inline constexpr float kAtan[5] = {0.9998660f, -0.3302995f, 0.1801410f, -0.0851330f, 0.0208351f};
+inline constexpr float kHalfPi = 1.57079637f;
+inline constexpr float kPi = 3.14159274f;
+inline constexpr float kTiny = 1e-30f;  // keeps atan2(0, 0) finite
+inline constexpr float kMsToS = 0.001f;
+
+// Fuses whole groups of 8 nodes from `begin`; returns the first node left
+// for the scalar kernel.
+using SimdFuse = std::size_t (*)(FusionState& s, const SampleBatch& in, std::size_t begin, std::size_t end,
+                                 const FusionConfig& cfg);
+
+void fuse_scalar(FusionState& s, const SampleBatch& in, std::size_t begin, std::size_t end,
+                 const FusionConfig& cfg);
+
+// Null when the SIMD kernel was not compiled in or the CPU lacks it.
+SimdFuse simd_fuse();
+const char* simd_fuse_name();
+
+}  // namespace g7::gateway::detail
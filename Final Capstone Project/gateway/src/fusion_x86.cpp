@@ -0,0 +1,154 @@
+// AVX2 fusion kernel: 8 nodes per pass, one lane per node. Functions carry a
+// target attribute instead of building the file with -mavx2, as in the DSP
+// library, so the gateway still runs on CPUs without AVX2.
+//
+// FMA is deliberately not enabled: every multiply and add rounds on its own,
+// as in fuse_scalar(), which keeps the two paths bit-exact. Branches become
+// lane masks: invalid slots, first samples and gated outliers are blended.
+
+#include "fusion_kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#include <cstring>
+
+#define G7_AVX2 __attribute__((target("avx2")))
+
+namespace g7::gateway::detail {
+namespace {
+
+G7_AVX2 inline __m256 load(const std::vector<float>& v, std::size_t i) { return _mm256_loadu_ps(v.data() + i); }
+
+G7_AVX2 inline void store(std::vector<float>& v, std::size_t i, __m256 x) { _mm256_storeu_ps(v.data() + i, x); }
+
+G7_AVX2 inline __m256i load(const std::vector<std::uint32_t>& v, std::size_t i) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.data() + i));
+}
+
+G7_AVX2 inline void store(std::vector<std::uint32_t>& v, std::size_t i, __m256i x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(v.data() + i), x);
+}
+
+G7_AVX2 inline __m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+G7_AVX2 inline __m256 sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+G7_AVX2 inline __m256 mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+G7_AVX2 inline __m256 splat(float v) { return _mm256_set1_ps(v); }
+// mask ? b : a
+G7_AVX2 inline __m256 pick(__m256 a, __m256 b, __m256 mask) { return _mm256_blendv_ps(a, b, mask); }
+
+// fast_atan2() lane by lane; min/max operand order matches std::min/max.
+G7_AVX2 __m256 atan2_ps(__m256 y, __m256 x) {
+    const __m256 sign = splat(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 ax = _mm256_andnot_ps(sign, x);
+    const __m256 ay = _mm256_andnot_ps(sign, y);
+    const __m256 a = _mm256_div_ps(_mm256_min_ps(ay, ax), _mm256_max_ps(splat(kTiny), _mm256_max_ps(ay, ax)));
+    const __m256 s = mul(a, a);
+    __m256 p = splat(kAtan[4]);
+    p = add(mul(p, s), splat(kAtan[3]));
+    p = add(mul(p, s), splat(kAtan[2]));
+    p = add(mul(p, s), splat(kAtan[1]));
+    p = add(mul(p, s), splat(kAtan[0]));
+    __m256 r = mul(p, a);
+    r = pick(r, sub(splat(kHalfPi), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    r = pick(r, sub(splat(kPi), r), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    return pick(r, _mm256_xor_ps(r, sign), _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+}
+
+G7_AVX2 std::size_t fuse_avx2(FusionState& s, const SampleBatch& in, std::size_t begin, std::size_t end,
+                              const FusionConfig& c) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 alpha = splat(c.alpha);
+    const __m256 oma = splat(1.0f - c.alpha);
+    const __m256 gate_on = c.gate > 0.0f ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : zero;
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        std::uint64_t valid8;
+        std::memcpy(&valid8, in.valid.data() + i, sizeof(valid8));
+        if (valid8 == 0) continue;
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in.valid.data() + i));
+        const __m256i valid_i = _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(bytes), _mm256_setzero_si256());
+        const __m256 valid = _mm256_castsi256_ps(valid_i);
+        const __m256i updates = load(s.updates, i);
+        const __m256 first = _mm256_castsi256_ps(_mm256_cmpeq_epi32(updates, _mm256_setzero_si256()));
+
+        const __m256 ax = load(in.ax, i), ay = load(in.ay, i), az = load(in.az, i);
+        const __m256 z = load(in.value, i);
+        const __m256 pa = atan2_ps(_mm256_xor_ps(ax, splat(-0.0f)), _mm256_sqrt_ps(add(mul(ay, ay), mul(az, az))));
+        const __m256 ra = atan2_ps(ay, az);
+
+        const __m256i t = load(in.t_ms, i);
+        const __m256i t_last = load(s.t_last, i);
+        __m256 dt = mul(_mm256_cvtepi32_ps(_mm256_sub_epi32(t, t_last)), splat(kMsToS));
+        dt = _mm256_min_ps(_mm256_max_ps(dt, zero), splat(c.dt_max));
+
+        const __m256 pitch0 = load(s.pitch, i), roll0 = load(s.roll, i);
+        __m256 pitch = add(mul(alpha, add(pitch0, mul(load(in.gy, i), dt))), mul(oma, pa));
+        __m256 roll = add(mul(alpha, add(roll0, mul(load(in.gx, i), dt))), mul(oma, ra));
+
+        const __m256 level0 = load(s.level, i), rate0 = load(s.rate, i);
+        const __m256 p00 = load(s.p00, i), p01 = load(s.p01, i), p11 = load(s.p11, i);
+        const __m256 xp = add(level0, mul(rate0, dt));
+        const __m256 p00p = add(add(p00, mul(dt, add(add(p01, p01), mul(dt, p11)))), mul(splat(c.q_value), dt));
+        const __m256 p01p = add(p01, mul(dt, p11));
+        const __m256 p11p = add(p11, mul(splat(c.q_rate), dt));
+        const __m256 y = sub(z, xp);
+        const __m256 sv = add(p00p, splat(c.r));
+        const __m256 reject =
+            _mm256_and_ps(gate_on, _mm256_cmp_ps(mul(y, y), mul(splat(c.gate), sv), _CMP_GT_OQ));
+        const __m256 k0 = _mm256_div_ps(p00p, sv);
+        const __m256 k1 = _mm256_div_ps(p01p, sv);
+        const __m256 one_k0 = sub(splat(1.0f), k0);
+        __m256 level = pick(add(xp, mul(k0, y)), xp, reject);
+        __m256 rate = pick(add(rate0, mul(k1, y)), rate0, reject);
+        __m256 n00 = pick(mul(one_k0, p00p), p00p, reject);
+        __m256 n01 = pick(mul(one_k0, p01p), p01p, reject);
+        __m256 n11 = pick(sub(p11p, mul(k1, p01p)), p11p, reject);
+
+        pitch = pick(pitch, pa, first);
+        roll = pick(roll, ra, first);
+        level = pick(level, z, first);
+        rate = pick(rate, zero, first);
+        n00 = pick(n00, splat(c.r), first);
+        n01 = pick(n01, zero, first);
+        n11 = pick(n11, splat(c.rate_var0), first);
+
+        store(s.pitch, i, pick(pitch0, pitch, valid));
+        store(s.roll, i, pick(roll0, roll, valid));
+        store(s.level, i, pick(level0, level, valid));
+        store(s.rate, i, pick(rate0, rate, valid));
+        store(s.p00, i, pick(p00, n00, valid));
+        store(s.p01, i, pick(p01, n01, valid));
+        store(s.p11, i, pick(p11, n11, valid));
+        store(s.t_last, i, _mm256_blendv_epi8(t_last, t, valid_i));
+        // Masks are all-ones lanes: subtracting one adds 1 where set.
+        store(s.updates, i, _mm256_sub_epi32(updates, valid_i));
+        const __m256i counted = _mm256_castps_si256(_mm256_andnot_ps(first, _mm256_and_ps(reject, valid)));
+        store(s.rejected, i, _mm256_sub_epi32(load(s.rejected, i), counted));
+    }
+    return i;
+}
+
+}  // namespace
+
+SimdFuse simd_fuse() {
+    static const bool ok = __builtin_cpu_supports("avx2");
+    return ok ? &fuse_avx2 : nullptr;
+}
+
+const char* simd_fuse_name() { return "avx2"; }
+
+}  // namespace g7::gateway::detail
+
+#else
+
+namespace g7::gateway::detail {
+
+SimdFuse simd_fuse() { return nullptr; }
+const char* simd_fuse_name() { return "none"; }
+
+}  // namespace g7::gateway::detail
+
+#endif
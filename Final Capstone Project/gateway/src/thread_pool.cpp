@@ -0,0 +1,188 @@
+// Chase-Lev deques and the worker loop behind ThreadPool.
+//
+// The deque follows Le, Pop, Cohen and Zappa Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013), minus the
+// resizing: a range is packed into one 64-bit word, begin << 32 | end.
+
+#include "g7/gateway/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace g7::gateway {
+
+namespace {
+
+constexpr std::size_t kMask = ThreadPool::kDequeSlots - 1;
+static_assert((ThreadPool::kDequeSlots & kMask) == 0, "deque size must be a power of two");
+
+constexpr std::uint64_t pack(std::size_t b, std::size_t e) { return (std::uint64_t{b} << 32) | e; }
+constexpr std::size_t begin_of(std::uint64_t r) { return static_cast<std::size_t>(r >> 32); }
+constexpr std::size_t end_of(std::uint64_t r) { return static_cast<std::size_t>(r & 0xFFFFFFFFu); }
+
+// Loops run in windows whose bounds fit the packed range.
+constexpr std::size_t kWindow = std::size_t{1} << 31;
+
+}  // namespace
+
+struct ThreadPool::Worker {
+    // Thieves write top, the owner writes bottom: keep them apart.
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::atomic<std::uint64_t> slots[kDequeSlots] = {};
+
+    alignas(64) WorkerStats stats;
+    std::uint64_t rng = 0;
+    std::thread thread;
+
+    // Owner only. False when full; the caller then runs the range itself.
+    bool push(std::uint64_t r) {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<std::int64_t>(kDequeSlots)) return false;
+        slots[static_cast<std::size_t>(b) & kMask].store(r, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only, newest first.
+    bool pop(std::uint64_t& r) {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        r = slots[static_cast<std::size_t>(b) & kMask].load(std::memory_order_relaxed);
+        if (t < b) return true;
+        // Last entry: race the thieves for it.
+        const bool won =
+            top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // Any thread, oldest first.
+    bool steal(std::uint64_t& r) {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        r = slots[static_cast<std::size_t>(t) & kMask].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+};
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    for (unsigned i = 1; i < threads; ++i) workers_[i]->thread = std::thread([this, i] { loop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    quit_.store(true);
+    epoch_.fetch_add(1);
+    epoch_.notify_all();
+    for (std::size_t i = 1; i < workers_.size(); ++i) workers_[i]->thread.join();
+}
+
+void ThreadPool::run(std::size_t n, std::size_t grain, Body body, void* ctx) {
+    body_ = body;
+    ctx_ = ctx;
+    grain_ = std::max<std::size_t>(grain, 1);
+    for (std::size_t base = 0; base < n; base += kWindow) {
+        const std::size_t count = std::min(kWindow, n - base);
+        offset_ = base;
+        remaining_.store(count);
+        if (workers_.size() > 1) {
+            epoch_.fetch_add(1);
+            epoch_.notify_all();
+        }
+        execute(*workers_[0], pack(0, count));
+        work(0);
+        // Workers may still be on their way out of this window.
+        while (busy_.load() != 0) std::this_thread::yield();
+    }
+}
+
+void ThreadPool::loop(unsigned id) {
+    std::uint32_t seen = 0;
+    for (;;) {
+        epoch_.wait(seen);
+        seen = epoch_.load();
+        if (quit_.load()) return;
+        busy_.fetch_add(1);
+        work(id);
+        busy_.fetch_sub(1);
+    }
+}
+
+void ThreadPool::work(unsigned id) {
+    Worker& w = *workers_[id];
+    unsigned idle = 0;
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        std::uint64_t r;
+        if (w.pop(r)) {
+            execute(w, r);
+        } else if (steal(id, r)) {
+            ++w.stats.steals;
+            execute(w, r);
+        } else if (++idle % 16 == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::execute(Worker& w, std::uint64_t range) {
+    std::size_t b = begin_of(range);
+    std::size_t e = end_of(range);
+    while (e - b > grain_) {
+        const std::size_t mid = b + (e - b) / 2;
+        if (!w.push(pack(mid, e))) break;
+        e = mid;
+    }
+    body_(ctx_, offset_ + b, offset_ + e);
+    ++w.stats.chunks;
+    w.stats.items += e - b;
+    remaining_.fetch_sub(e - b, std::memory_order_acq_rel);
+}
+
+bool ThreadPool::steal(unsigned id, std::uint64_t& range) {
+    const std::size_t n = workers_.size();
+    if (n < 2) return false;
+    // xorshift64 picks the first victim; the rest are tried in order.
+    std::uint64_t& x = workers_[id]->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    const std::size_t start = static_cast<std::size_t>(x % n);
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t v = (start + k) % n;
+        if (v != id && workers_[v]->steal(range)) return true;
+    }
+    return false;
+}
+
+WorkerStats ThreadPool::stats(unsigned worker) const { return workers_[worker]->stats; }
+
+WorkerStats ThreadPool::total_stats() const {
+    WorkerStats t;
+    for (const auto& w : workers_) {
+        t.chunks += w->stats.chunks;
+        t.items += w->stats.items;
+        t.steals += w->stats.steals;
+    }
+    return t;
+}
+
+void ThreadPool::reset_stats() {
+    for (auto& w : workers_) w->stats = WorkerStats{};
+}
+
+}  // namespace g7::gateway
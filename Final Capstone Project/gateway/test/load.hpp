@@ -0,0 +1,125 @@
+// The 10k-node load generator. Shared by the gateway test and benchmarks.
+//
+// The generator simulates kNodes tilted, wobbling nodes, each reporting
+// accelerometer, gyro and a drifting scalar channel in milli-units, as over
+// the telemetry link. Traffic is uneven: one node in ten bursts up to four
+// reports per 20 ms frame, and one in twenty misses a frame. A few value
+// readings are outliers for the Kalman gate to reject.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "g7/gateway.hpp"
+
+namespace g7::gateway::test {
+
+namespace gw = g7::gateway;
+
+inline constexpr std::size_t kNodes = 10000;
+inline constexpr std::size_t kFrames = 32;
+inline constexpr std::uint32_t kFrameMs = 20;
+inline constexpr float kOutlier = 40.0f;
+
+struct Report {
+    std::uint32_t node;
+    gw::Sample s;
+};
+
+struct Truth {
+    float pitch = 0, roll = 0, value = 0;
+};
+
+struct Load {
+    std::vector<std::vector<Report>> frames;  // time-ordered within a frame
+    std::vector<Truth> truth;                 // at each node's last report
+    std::size_t reports = 0;
+    std::size_t outliers = 0;
+};
+
+inline std::uint64_t xorshift(std::uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+inline float uniform(std::uint64_t& x) {
+    return static_cast<float>(xorshift(x) >> 40) / static_cast<float>(1u << 24);
+}
+
+// What the node puts on the wire, and what to_sample() turns it back into.
+inline std::int32_t milli(double v) { return static_cast<std::int32_t>(std::lround(v * 1000.0)); }
+inline float unmilli(std::int32_t v) { return static_cast<float>(v) * 0.001f; }
+
+inline Load make_load(std::size_t nodes, std::size_t frames) {
+    Load load;
+    load.frames.resize(frames);
+    load.truth.resize(nodes);
+    std::uint64_t rng = 0x2545F4914F6CDD1Dull;
+    std::vector<double> p0(nodes), r0(nodes), w(nodes), v0(nodes), slope(nodes);
+    for (std::size_t n = 0; n < nodes; ++n) {
+        p0[n] = 0.6 * (uniform(rng) - 0.5);
+        r0[n] = 0.6 * (uniform(rng) - 0.5);
+        w[n] = 0.5 + 2.0 * uniform(rng);
+        v0[n] = 20.0 + 10.0 * uniform(rng);
+        slope[n] = 0.2 * (uniform(rng) - 0.5);
+    }
+    for (std::size_t f = 0; f < frames; ++f) {
+        std::vector<Report>& out = load.frames[f];
+        for (std::size_t n = 0; n < nodes; ++n) {
+            const std::uint64_t roll_dice = xorshift(rng);
+            const unsigned count = n % 10 == 0 ? 1 + static_cast<unsigned>(roll_dice % 4) : roll_dice % 20 == 0 ? 0 : 1;
+            for (unsigned j = 0; j < count; ++j) {
+                const std::uint32_t t_ms = static_cast<std::uint32_t>(f) * kFrameMs + j * (kFrameMs / count);
+                const double t = t_ms * 1e-3;
+                const double pitch = p0[n] + 0.2 * std::sin(w[n] * t);
+                const double roll = r0[n] + 0.1 * std::cos(w[n] * t);
+                const double noise = 0.004 * (uniform(rng) - 0.5);
+                double value = v0[n] + slope[n] * t;
+                load.truth[n] = {static_cast<float>(pitch), static_cast<float>(roll), static_cast<float>(value)};
+                value += 0.1 * (uniform(rng) - 0.5);
+                // Outliers from the second frame on, once the filter has settled.
+                if (f > 1 && xorshift(rng) % 1000 == 0) {
+                    value += kOutlier;
+                    ++load.outliers;
+                }
+                gw::Sample s;
+                s.t_ms = t_ms;
+                s.ax = unmilli(milli(-std::sin(pitch) + noise));
+                s.ay = unmilli(milli(std::sin(roll) * std::cos(pitch) + noise));
+                s.az = unmilli(milli(std::cos(roll) * std::cos(pitch) - noise));
+                s.gx = unmilli(milli(-0.1 * w[n] * std::sin(w[n] * t)));
+                s.gy = unmilli(milli(0.2 * w[n] * std::cos(w[n] * t)));
+                s.value = unmilli(milli(value));
+                out.push_back({static_cast<std::uint32_t>(n), s});
+            }
+        }
+        std::stable_sort(out.begin(), out.end(), [](const Report& a, const Report& b) { return a.s.t_ms < b.s.t_ms; });
+        load.reports += out.size();
+    }
+    return load;
+}
+
+inline const Load& load() {
+    static const Load l = make_load(kNodes, kFrames);
+    return l;
+}
+
+inline void run_frames(gw::Engine& engine, const Load& l) {
+    for (const auto& frame : l.frames) {
+        for (const Report& r : frame) engine.push(r.node, r.s);
+        engine.step();
+    }
+}
+
+inline gw::EngineConfig config(gw::Path path) {
+    gw::EngineConfig cfg;
+    cfg.nodes = kNodes;
+    cfg.path = path;
+    return cfg;
+}
+
+}  // namespace g7::gateway::test
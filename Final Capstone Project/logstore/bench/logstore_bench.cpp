@@ -0,0 +1,192 @@
+// Append throughput, recovery time and write amplification of the flash log
+// store on the host flash emulator.
+//
+//   ./g7_logstore_bench --benchmark_counters_tabular=true
+//
+// Recovery after power loss is checked by g7_logstore_test.
+//
+// Counters:
+//   - Append: host records/s and payload bytes/s, write amplification
+//     (flash bytes programmed per payload byte), and device_KiB/s, the
+//     payload rate under the emulator's SPI NOR timing model.
+//   - Recover: the time to mount a full chip, which is what an unclean
+//     reboot costs.
+//   - Queries: ns/query for the indexed lookups and for a linear scan.
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "g7/logstore.hpp"
+
+namespace ls = g7::logstore;
+
+namespace {
+
+std::string g_path;
+
+bool open_flash(ls::FileFlash& flash, const ls::Geometry& g) {
+    std::string error;
+    if (!flash.open(g_path, g, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Appends records with fixed-size payloads until the log has wrapped about
+// `laps` times.
+bool fill(ls::LogStore& log, const ls::Geometry& g, std::size_t payload, double laps, std::uint32_t& id) {
+    std::string error;
+    std::uint8_t buf[4096] = {};
+    const auto n = static_cast<std::uint64_t>(laps * g.size() / (payload + ls::LogStore::kRecordHeader));
+    for (std::uint64_t i = 0; i < n; ++i, ++id) {
+        std::memcpy(buf, &id, sizeof(id));
+        if (!log.append(id, buf, payload, error)) {
+            std::fprintf(stderr, "append: %s\n", error.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+
+constexpr ls::Geometry kChip{4096, 256, 4};  // 1 MiB SPI NOR
+
+void BM_Append(benchmark::State& state) {
+    const auto payload = static_cast<std::size_t>(state.range(0));
+    ls::FileFlash flash;
+    if (!open_flash(flash, kChip)) return state.SkipWithError("cannot open flash file");
+    ls::LogStore log(flash);
+    std::string error;
+    if (!log.format(error)) return state.SkipWithError(error.c_str());
+    log.reset_stats();
+    flash.reset_stats();
+
+    std::uint8_t buf[256] = {};
+    std::uint32_t id = 0;
+    for (auto _ : state) {
+        std::memcpy(buf, &id, sizeof(id));
+        if (!log.append(id, buf, payload, error)) return state.SkipWithError(error.c_str());
+        ++id;
+    }
+    const ls::LogStats& s = log.stats();
+    state.SetItemsProcessed(static_cast<std::int64_t>(s.appends));
+    state.SetBytesProcessed(static_cast<std::int64_t>(s.payload_bytes));
+    state.counters["WA"] = s.write_amplification();
+    state.counters["laps"] = static_cast<double>(s.erases) / kChip.sector_count;
+    state.counters["device_KiB/s"] = static_cast<double>(s.payload_bytes) / 1024.0 /
+                                     (static_cast<double>(flash.stats().busy_ns) * 1e-9);
+}
+BENCHMARK(BM_Append)->Arg(16)->Arg(64)->Arg(256);
+
+// Mount time of a full chip whose last append was torn.
+void BM_Recover(benchmark::State& state) {
+    const ls::Geometry g{4096, static_cast<std::uint32_t>(state.range(0)), 4};
+    ls::FileFlash flash;
+    if (!open_flash(flash, g)) return state.SkipWithError("cannot open flash file");
+    std::string error;
+    std::uint32_t id = 0;
+    {
+        ls::LogStore log(flash);
+        if (!log.format(error) || !fill(log, g, 32, 1.2, id)) return state.SkipWithError("fill failed");
+        flash.arm_power_loss(1, 5);
+        std::uint8_t buf[32] = {};
+        log.append(id, buf, sizeof(buf), error);
+        flash.power_cycle();
+    }
+    std::size_t records = 0;
+    for (auto _ : state) {
+        ls::LogStore log(flash);
+        if (!log.mount(error)) return state.SkipWithError(error.c_str());
+        records = log.records();
+    }
+    state.counters["records"] = static_cast<double>(records);
+    state.counters["flash_KiB"] = static_cast<double>(g.size()) / 1024.0;
+}
+BENCHMARK(BM_Recover)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+// Queries on a full 1 MiB log of 32-byte records.
+struct FullLog {
+    ls::FileFlash flash;
+    std::unique_ptr<ls::LogStore> log;
+    std::uint32_t first = 0, last = 0;
+
+    bool init() {
+        if (!open_flash(flash, kChip)) return false;
+        log = std::make_unique<ls::LogStore>(flash);
+        std::string error;
+        std::uint32_t id = 0;
+        if (!log->format(error) || !fill(*log, kChip, 32, 1.5, id)) return false;
+        ls::Entry e;
+        ls::Cursor c = log->oldest();
+        log->next(c, e);
+        first = e.timestamp;
+        last = id - 1;
+        return true;
+    }
+};
+
+void BM_Newest(benchmark::State& state) {
+    FullLog f;
+    if (!f.init()) return state.SkipWithError("fill failed");
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::uint64_t sum = 0;
+    for (auto _ : state) {
+        ls::Entry e;
+        for (ls::Cursor c = f.log->newest(n); f.log->next(c, e);) sum += e.timestamp;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["ns/query"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Newest)->Arg(1)->Arg(100);
+
+// Finds the first record at or after a random time.
+void BM_Seek(benchmark::State& state) {
+    FullLog f;
+    if (!f.init()) return state.SkipWithError("fill failed");
+    const bool indexed = state.range(0) != 0;
+    std::mt19937 rng(3);
+    std::uint64_t sum = 0;
+    for (auto _ : state) {
+        const std::uint32_t t = f.first + rng() % (f.last - f.first);
+        ls::Entry e;
+        ls::Cursor c = indexed ? f.log->seek(t) : f.log->oldest();
+        while (f.log->next(c, e) && e.timestamp < t) {
+        }
+        sum += e.timestamp;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetLabel(indexed ? "index" : "scan");
+    state.counters["ns/query"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Seek)->Arg(1)->Arg(0);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    char name[] = "/tmp/g7_logstore_XXXXXX";
+    const int fd = mkstemp(name);
+    if (fd < 0) {
+        std::fprintf(stderr, "cannot create the flash file\n");
+        return 2;
+    }
+    close(fd);
+    g_path = name;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    std::remove(name);
+    return 0;
+}
@@ -0,0 +1,6 @@
+// Umbrella header for the flash log store.
+#pragma once
+
+#include "g7/logstore/file_flash.hpp"
+#include "g7/logstore/flash.hpp"
+#include "g7/logstore/log_store.hpp"
@@ -0,0 +1,83 @@
+// Host NOR flash emulator backed by an mmap'ed file.
+//
+//   g7::logstore::FileFlash flash;
+//   if (!flash.open("/tmp/nor.bin", {4096, 256, 4}, error)) ...
+//   flash.arm_power_loss(1 + rng() % 500, seed);   // tear a random later op
+//
+// The file holds the array, so contents survive a process restart as well as
+// power_cycle(). Programming ANDs into the array like real NOR; an attempt
+// to set a 0 bit back to 1 is counted in stats().overwrites, which a correct
+// store never does. Program and erase time follow `FlashTiming`, a typical
+// SPI NOR datasheet by default, so a run can report device-side throughput
+// as well as host time.
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "g7/logstore/flash.hpp"
+
+namespace g7::logstore {
+
+struct FlashTiming {
+    std::uint32_t program_ns_per_byte = 1600;  // 256-byte page in ~0.4 ms
+    std::uint32_t erase_us = 45000;            // 4 KiB sector
+};
+
+struct FlashStats {
+    std::uint64_t programs = 0;
+    std::uint64_t programmed_bytes = 0;
+    std::uint64_t erases = 0;
+    std::uint64_t busy_ns = 0;     // modelled device time
+    std::uint64_t overwrites = 0;  // programs that tried to set a bit
+    std::uint64_t rejected = 0;    // misaligned or out of range
+    std::uint64_t torn = 0;        // operations cut by power loss
+};
+
+class FileFlash final : public Flash {
+public:
+    FileFlash() = default;
+    ~FileFlash() override { close(); }
+    FileFlash(const FileFlash&) = delete;
+    FileFlash& operator=(const FileFlash&) = delete;
+
+    // Maps `path`, creating it as an erased chip if its size does not match
+    // the geometry. Returns false and sets `error` on failure.
+    bool open(const std::string& path, const Geometry& geometry, std::string& error);
+    void close();
+    bool is_open() const { return map_ != nullptr; }
+
+    const Geometry& geometry() const override { return geo_; }
+    const std::uint8_t* data() const override { return map_; }
+    bool program(std::uint32_t addr, const std::uint8_t* src, std::uint32_t n) override;
+    bool erase(std::uint32_t sector) override;
+
+    // The `ops`-th program or erase from now (1 = the next one) stops at a
+    // random byte, leaving the last byte partly programmed; every later
+    // operation fails until power_cycle().
+    void arm_power_loss(std::uint64_t ops, std::uint64_t seed);
+    bool powered() const { return powered_; }
+    void power_cycle();
+
+    void set_timing(const FlashTiming& t) { timing_ = t; }
+    std::uint32_t erase_count(std::uint32_t sector) const { return erase_counts_[sector]; }
+    const FlashStats& stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+private:
+    bool tear_now();
+
+    Geometry geo_;
+    FlashTiming timing_;
+    FlashStats stats_;
+    std::uint8_t* map_ = nullptr;
+    int fd_ = -1;
+    std::vector<std::uint32_t> erase_counts_;
+    std::uint64_t armed_ = 0;  // ops left until the torn one, 0 if disarmed
+    std::mt19937_64 rng_;
+    bool powered_ = true;
+};
+
+}  // namespace g7::logstore
@@ -0,0 +1,33 @@
+// NOR flash as the log store sees it.
+//
+// Erase sets a whole sector to 0xFF and programming can only clear bits, so
+// a byte is written once per erase. Reads go through the memory-mapped
+// array (XIP on the target, an mmap on the host): the store hands out
+// payloads as spans straight into flash and never copies them out.
+#pragma once
+
+#include <cstdint>
+
+namespace g7::logstore {
+
+struct Geometry {
+    std::uint32_t sector_size = 4096;
+    std::uint32_t sector_count = 256;
+    std::uint32_t program_unit = 4;  // program address and length alignment
+
+    constexpr std::uint32_t size() const { return sector_size * sector_count; }
+};
+
+class Flash {
+public:
+    virtual ~Flash() = default;
+    virtual const Geometry& geometry() const = 0;
+    // Base of the memory-mapped array, geometry().size() bytes.
+    virtual const std::uint8_t* data() const = 0;
+    // Both return false if the operation did not complete, e.g. because
+    // power failed part way; the affected bytes are then indeterminate.
+    virtual bool program(std::uint32_t addr, const std::uint8_t* src, std::uint32_t n) = 0;
+    virtual bool erase(std::uint32_t sector) = 0;
+};
+
+}  // namespace g7::logstore
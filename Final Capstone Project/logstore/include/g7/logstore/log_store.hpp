@@ -0,0 +1,146 @@
+// Append-only, power-loss-safe record log for NOR flash.
+//
+//   g7::logstore::LogStore log(flash);
+//   if (!log.mount(error)) ...                 // recovers after any reset
+//   log.append(t_ms, payload, len, error);
+//
+//   g7::logstore::Entry e;
+//   for (auto c = log.seek(t0); log.next(c, e) && e.timestamp < t1;) use(e);
+//   for (auto c = log.newest(100); log.next(c, e);) use(e);
+//
+// Layout: the sectors form a ring. Each starts with a 16-byte header (magic,
+// sequence number, erase count, CRC-32); records follow back to back, each
+// a 12-byte header (length, its complement, timestamp, CRC-32 over header
+// and payload) plus the payload, padded to the program unit. When the head
+// sector is full the next one in the ring is erased and takes a higher
+// sequence number, so the oldest sector's records are dropped and every
+// sector is erased equally often.
+//
+// A record is durable once append() returns true. Power loss during an
+// append leaves at most a torn tail, which fails its CRC; mount() stops the
+// sector there and appends resume in a fresh sector. A torn erase or sector
+// header leaves a sector without a valid header, which is treated as free.
+//
+// The in-RAM index holds, per sector, its sequence number, record count and
+// timestamp range, plus a checkpoint (timestamp, offset, ordinal) for the
+// first record in each `index_stride` bytes. newest() and seek() use it to
+// land within one stride of the answer instead of scanning the log. All
+// index memory is allocated by mount(); append() and the queries do not
+// allocate. Timestamps must not decrease.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "g7/logstore/flash.hpp"
+
+namespace g7::logstore {
+
+struct Config {
+    std::uint32_t index_stride = 1024;  // bytes of sector per checkpoint
+};
+
+struct Entry {
+    std::uint32_t timestamp = 0;
+    std::span<const std::uint8_t> payload;
+};
+
+// Position in the log; invalidated by append().
+struct Cursor {
+    std::size_t pos = 0;  // index into the sectors in log order
+    std::uint32_t offset = 0;
+};
+
+struct LogStats {
+    std::uint64_t appends = 0;
+    std::uint64_t payload_bytes = 0;
+    std::uint64_t programmed_bytes = 0;  // record and sector headers, padding included
+    std::uint64_t erases = 0;
+    std::uint64_t dropped_records = 0;  // lost to sector rotation
+    std::uint64_t failed = 0;           // appends the flash did not complete
+
+    // Flash bytes programmed per payload byte.
+    double write_amplification() const {
+        return payload_bytes ? static_cast<double>(programmed_bytes) / static_cast<double>(payload_bytes) : 0.0;
+    }
+};
+
+class LogStore {
+public:
+    static constexpr std::uint32_t kSectorHeader = 16;
+    static constexpr std::uint32_t kRecordHeader = 12;
+
+    explicit LogStore(Flash& flash, const Config& config = {}) : flash_(flash), config_(config) {}
+
+    // Rebuilds the index from flash, formatting the first sector if none is
+    // valid. Returns false and sets `error` on a bad geometry or flash error.
+    bool mount(std::string& error);
+    // Erases every sector and mounts an empty log.
+    bool format(std::string& error);
+
+    bool append(std::uint32_t timestamp, const std::uint8_t* data, std::size_t n, std::string& error);
+
+    Cursor oldest() const { return {0, kSectorHeader}; }
+    // next() then yields the newest n records, oldest of them first.
+    Cursor newest(std::size_t n) const;
+    // The first record with timestamp >= t.
+    Cursor seek(std::uint32_t t) const;
+    // Reads the record at `c` into `e` and steps past it; false at the end.
+    bool next(Cursor& c, Entry& e) const;
+
+    std::size_t records() const { return records_; }
+    std::uint32_t max_payload() const;
+    // Lowest and highest erase count among the sectors.
+    std::uint32_t min_erases() const;
+    std::uint32_t max_erases() const;
+    std::size_t index_bytes() const;
+    const LogStats& stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+private:
+    struct SectorInfo {
+        std::uint32_t seq = 0;  // 0: no valid header
+        std::uint32_t erase_count = 0;
+        std::uint32_t first_ts = 0;
+        std::uint32_t last_ts = 0;
+        std::uint32_t records = 0;
+        std::uint32_t end = 0;  // offset past the last valid record
+        std::uint32_t checkpoints = 0;
+    };
+
+    struct Checkpoint {
+        std::uint32_t timestamp;
+        std::uint16_t offset;
+        std::uint16_t ordinal;
+    };
+
+    const std::uint8_t* sector_base(std::uint32_t s) const {
+        return flash_.data() + std::size_t{s} * flash_.geometry().sector_size;
+    }
+    std::uint32_t record_size(std::size_t payload) const;
+    void scan(std::uint32_t s);
+    void index_record(std::uint32_t s, std::uint32_t offset, std::uint32_t timestamp);
+    bool open_sector(std::string& error);
+    // Cursor at the ordinal-th record of the sector at log position `pos`.
+    Cursor locate(std::size_t pos, std::uint32_t ordinal) const;
+
+    Flash& flash_;
+    Config config_;
+    bool mounted_ = false;
+    bool head_open_ = false;  // false: head sector is full or has a torn tail
+    std::uint32_t head_ = 0;
+    std::uint32_t next_seq_ = 1;
+    std::uint32_t last_ts_ = 0;
+    std::uint32_t checkpoints_per_sector_ = 0;
+    std::size_t records_ = 0;
+    std::vector<SectorInfo> sectors_;
+    std::vector<Checkpoint> checkpoints_;  // checkpoints_per_sector_ per sector
+    std::vector<std::uint32_t> order_;     // valid sectors, oldest first
+    std::vector<std::uint8_t> scratch_;    // one record being built
+    LogStats stats_;
+};
+
+}  // namespace g7::logstore
@@ -0,0 +1,116 @@
+#include "g7/logstore/file_flash.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace g7::logstore {
+
+bool FileFlash::open(const std::string& path, const Geometry& geometry, std::string& error) {
+    close();
+    if (geometry.sector_size == 0 || geometry.sector_count == 0 || geometry.program_unit == 0 ||
+        geometry.sector_size % geometry.program_unit != 0) {
+        error = "bad flash geometry";
+        return false;
+    }
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat st {};
+    bool fresh = false;
+    if (::fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) != geometry.size()) {
+        if (::ftruncate(fd, static_cast<off_t>(geometry.size())) != 0) {
+            ::close(fd);
+            error = path + ": cannot resize";
+            return false;
+        }
+        fresh = true;
+    }
+    void* p = ::mmap(nullptr, geometry.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        error = path + ": mmap failed";
+        return false;
+    }
+    fd_ = fd;
+    map_ = static_cast<std::uint8_t*>(p);
+    geo_ = geometry;
+    if (fresh) std::memset(map_, 0xFF, geo_.size());
+    erase_counts_.assign(geo_.sector_count, 0);
+    stats_ = {};
+    armed_ = 0;
+    powered_ = true;
+    return true;
+}
+
+void FileFlash::close() {
+    if (map_ != nullptr) ::munmap(map_, geo_.size());
+    if (fd_ >= 0) ::close(fd_);
+    map_ = nullptr;
+    fd_ = -1;
+}
+
+bool FileFlash::program(std::uint32_t addr, const std::uint8_t* src, std::uint32_t n) {
+    if (!powered_ || map_ == nullptr) return false;
+    if (addr % geo_.program_unit != 0 || n % geo_.program_unit != 0 || addr > geo_.size() ||
+        n > geo_.size() - addr) {
+        ++stats_.rejected;
+        return false;
+    }
+    const bool torn = tear_now();
+    std::uint32_t done = n;
+    if (torn && n > 0) done = static_cast<std::uint32_t>(rng_() % n);
+
+    std::uint8_t* dst = map_ + addr;
+    bool overwrite = false;
+    for (std::uint32_t i = 0; i < done; ++i) {
+        overwrite |= (dst[i] & src[i]) != src[i];
+        dst[i] &= src[i];
+    }
+    if (torn && done < n) dst[done] &= static_cast<std::uint8_t>(src[done] | rng_());
+    stats_.overwrites += overwrite ? 1 : 0;
+    ++stats_.programs;
+    stats_.programmed_bytes += done;
+    stats_.busy_ns += std::uint64_t{done} * timing_.program_ns_per_byte;
+    return !torn;
+}
+
+bool FileFlash::erase(std::uint32_t sector) {
+    if (!powered_ || map_ == nullptr) return false;
+    if (sector >= geo_.sector_count) {
+        ++stats_.rejected;
+        return false;
+    }
+    // A torn erase clears a random prefix and leaves the rest as it was.
+    const bool torn = tear_now();
+    const std::uint32_t n = torn ? static_cast<std::uint32_t>(rng_() % geo_.sector_size) : geo_.sector_size;
+    std::memset(map_ + std::size_t{sector} * geo_.sector_size, 0xFF, n);
+    ++erase_counts_[sector];
+    ++stats_.erases;
+    stats_.busy_ns += std::uint64_t{timing_.erase_us} * 1000;
+    return !torn;
+}
+
+void FileFlash::arm_power_loss(std::uint64_t ops, std::uint64_t seed) {
+    armed_ = ops;
+    rng_.seed(seed);
+}
+
+void FileFlash::power_cycle() {
+    powered_ = true;
+    armed_ = 0;
+}
+
+bool FileFlash::tear_now() {
+    if (armed_ == 0 || --armed_ != 0) return false;
+    powered_ = false;
+    ++stats_.torn;
+    return true;
+}
+
+}  // namespace g7::logstore
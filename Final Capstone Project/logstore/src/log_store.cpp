@@ -0,0 +1,325 @@
+#include "g7/logstore/log_store.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace g7::logstore {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x534C3747;  // "G7LS"
+
+constexpr std::array<std::uint32_t, 256> make_crc_table() {
+    std::array<std::uint32_t, 256> t{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        t[i] = c;
+    }
+    return t;
+}
+
+constexpr auto kCrcTable = make_crc_table();
+
+// CRC-32 (IEEE), chainable: pass the previous result as `crc`.
+std::uint32_t crc32(const std::uint8_t* p, std::size_t n, std::uint32_t crc = 0) {
+    crc = ~crc;
+    for (std::size_t i = 0; i < n; ++i) crc = kCrcTable[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+std::uint32_t load32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint16_t load16(const std::uint8_t* p) {
+    std::uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void store32(std::uint8_t* p, std::uint32_t v) { std::memcpy(p, &v, sizeof(v)); }
+void store16(std::uint8_t* p, std::uint16_t v) { std::memcpy(p, &v, sizeof(v)); }
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Mount
+
+bool LogStore::mount(std::string& error) {
+    const Geometry& g = flash_.geometry();
+    const std::uint32_t unit = g.program_unit;
+    if (unit == 0 || unit > kSectorHeader || kSectorHeader % unit != 0 || g.sector_size % unit != 0 ||
+        g.sector_size > 0x10000 || g.sector_size < kSectorHeader + kRecordHeader + unit || g.sector_count < 2 ||
+        config_.index_stride == 0) {
+        error = "unsupported flash geometry";
+        return false;
+    }
+
+    mounted_ = false;
+    records_ = 0;
+    last_ts_ = 0;
+    checkpoints_per_sector_ = (g.sector_size + config_.index_stride - 1) / config_.index_stride;
+    sectors_.assign(g.sector_count, SectorInfo{});
+    checkpoints_.assign(std::size_t{g.sector_count} * checkpoints_per_sector_, Checkpoint{});
+    order_.clear();
+    order_.reserve(g.sector_count);
+    scratch_.assign(g.sector_size, 0xFF);
+
+    std::uint32_t max_erases = 0;
+    for (std::uint32_t s = 0; s < g.sector_count; ++s) {
+        const std::uint8_t* h = sector_base(s);
+        const std::uint32_t seq = load32(h + 4);
+        if (load32(h) != kMagic || seq == 0 || crc32(h, 12) != load32(h + 12)) continue;
+        sectors_[s].seq = seq;
+        sectors_[s].erase_count = load32(h + 8);
+        max_erases = std::max(max_erases, sectors_[s].erase_count);
+        order_.push_back(s);
+    }
+    // A sector without a valid header lost its erase count; assume the worst.
+    for (SectorInfo& info : sectors_) {
+        if (info.seq == 0) info.erase_count = max_erases;
+    }
+    std::sort(order_.begin(), order_.end(),
+              [this](std::uint32_t a, std::uint32_t b) { return sectors_[a].seq < sectors_[b].seq; });
+    for (std::uint32_t s : order_) {
+        scan(s);
+        records_ += sectors_[s].records;
+        if (sectors_[s].records > 0) last_ts_ = sectors_[s].last_ts;
+    }
+    mounted_ = true;
+
+    if (order_.empty()) {
+        head_ = g.sector_count - 1;  // so the first sector opened is 0
+        next_seq_ = 1;
+        head_open_ = false;
+        return open_sector(error);
+    }
+
+    head_ = order_.back();
+    next_seq_ = sectors_[head_].seq + 1;
+    // Appends may only continue in place if everything past the last good
+    // record is still erased; a torn record sends them to a fresh sector.
+    const std::uint8_t* base = sector_base(head_);
+    head_open_ = std::all_of(base + sectors_[head_].end, base + g.sector_size,
+                             [](std::uint8_t b) { return b == 0xFF; });
+    return true;
+}
+
+bool LogStore::format(std::string& error) {
+    for (std::uint32_t s = 0; s < flash_.geometry().sector_count; ++s) {
+        if (!flash_.erase(s)) {
+            error = "flash erase failed";
+            mounted_ = false;
+            return false;
+        }
+        ++stats_.erases;
+    }
+    return mount(error);
+}
+
+void LogStore::scan(std::uint32_t s) {
+    const std::uint32_t size = flash_.geometry().sector_size;
+    const std::uint8_t* base = sector_base(s);
+    std::uint32_t off = kSectorHeader;
+    while (off + kRecordHeader <= size) {
+        const std::uint8_t* r = base + off;
+        const std::uint16_t len = load16(r);
+        const std::uint16_t inv = load16(r + 2);
+        if (len == 0xFFFF && inv == 0xFFFF) break;  // erased: end of the sector's log
+        if ((len ^ inv) != 0xFFFF) break;
+        const std::uint32_t total = record_size(len);
+        if (total > size - off) break;
+        if (crc32(r + kRecordHeader, len, crc32(r, 8)) != load32(r + 8)) break;
+        index_record(s, off, load32(r + 4));
+        off += total;
+    }
+    sectors_[s].end = off;
+}
+
+void LogStore::index_record(std::uint32_t s, std::uint32_t offset, std::uint32_t timestamp) {
+    SectorInfo& info = sectors_[s];
+    if (info.checkpoints < checkpoints_per_sector_ && offset >= info.checkpoints * config_.index_stride) {
+        checkpoints_[std::size_t{s} * checkpoints_per_sector_ + info.checkpoints++] = {
+            timestamp, static_cast<std::uint16_t>(offset), static_cast<std::uint16_t>(info.records)};
+    }
+    if (info.records == 0) info.first_ts = timestamp;
+    info.last_ts = timestamp;
+    ++info.records;
+}
+
+// ---------------------------------------------------------------------------
+// Append
+
+std::uint32_t LogStore::record_size(std::size_t payload) const {
+    const std::uint32_t unit = flash_.geometry().program_unit;
+    return static_cast<std::uint32_t>((kRecordHeader + payload + unit - 1) / unit * unit);
+}
+
+std::uint32_t LogStore::max_payload() const {
+    return std::min<std::uint32_t>(0xFFFE, flash_.geometry().sector_size - kSectorHeader - kRecordHeader);
+}
+
+// Erases the sector after the head and makes it the new head. The sector's
+// old records, the oldest in the log, are dropped first so the index never
+// points at erased flash.
+bool LogStore::open_sector(std::string& error) {
+    const Geometry& g = flash_.geometry();
+    const std::uint32_t next = (head_ + 1) % g.sector_count;
+    SectorInfo& info = sectors_[next];
+    if (info.seq != 0) {
+        order_.erase(std::find(order_.begin(), order_.end(), next));
+        records_ -= info.records;
+        stats_.dropped_records += info.records;
+    }
+    info = SectorInfo{0, info.erase_count + 1};
+
+    ++stats_.erases;
+    if (!flash_.erase(next)) {
+        error = "flash erase failed";
+        return false;
+    }
+    std::uint8_t h[kSectorHeader];
+    store32(h, kMagic);
+    store32(h + 4, next_seq_);
+    store32(h + 8, info.erase_count);
+    store32(h + 12, crc32(h, 12));
+    stats_.programmed_bytes += kSectorHeader;
+    if (!flash_.program(next * g.sector_size, h, kSectorHeader)) {
+        error = "flash program failed";
+        return false;
+    }
+    info.seq = next_seq_++;
+    info.end = kSectorHeader;
+    order_.push_back(next);
+    head_ = next;
+    head_open_ = true;
+    return true;
+}
+
+bool LogStore::append(std::uint32_t timestamp, const std::uint8_t* data, std::size_t n, std::string& error) {
+    if (!mounted_) {
+        error = "log store not mounted";
+        return false;
+    }
+    if (n > max_payload()) {
+        error = "record larger than " + std::to_string(max_payload()) + " bytes";
+        return false;
+    }
+    if (timestamp < last_ts_) {
+        error = "timestamp goes backwards";
+        return false;
+    }
+    const Geometry& g = flash_.geometry();
+    const std::uint32_t total = record_size(n);
+    if (!head_open_ || sectors_[head_].end + total > g.sector_size) {
+        if (!open_sector(error)) {
+            ++stats_.failed;
+            return false;
+        }
+    }
+
+    std::uint8_t* r = scratch_.data();
+    const auto len = static_cast<std::uint16_t>(n);
+    store16(r, len);
+    store16(r + 2, static_cast<std::uint16_t>(~len));
+    store32(r + 4, timestamp);
+    if (n > 0) std::memcpy(r + kRecordHeader, data, n);
+    std::memset(r + kRecordHeader + n, 0xFF, total - kRecordHeader - n);
+    store32(r + 8, crc32(r + kRecordHeader, n, crc32(r, 8)));
+
+    SectorInfo& info = sectors_[head_];
+    stats_.programmed_bytes += total;
+    if (!flash_.program(head_ * g.sector_size + info.end, r, total)) {
+        // Whatever reached flash is garbage now; never program over it.
+        head_open_ = false;
+        ++stats_.failed;
+        error = "flash program failed";
+        return false;
+    }
+    index_record(head_, info.end, timestamp);
+    info.end += total;
+    ++records_;
+    last_ts_ = timestamp;
+    ++stats_.appends;
+    stats_.payload_bytes += n;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+
+Cursor LogStore::locate(std::size_t pos, std::uint32_t ordinal) const {
+    const std::uint32_t s = order_[pos];
+    const Checkpoint* cp = &checkpoints_[std::size_t{s} * checkpoints_per_sector_];
+    std::uint32_t i = 0;
+    while (i + 1 < sectors_[s].checkpoints && cp[i + 1].ordinal <= ordinal) ++i;
+    std::uint32_t off = sectors_[s].checkpoints ? cp[i].offset : kSectorHeader;
+    std::uint32_t at = sectors_[s].checkpoints ? cp[i].ordinal : 0;
+    for (const std::uint8_t* base = sector_base(s); at < ordinal; ++at) off += record_size(load16(base + off));
+    return {pos, off};
+}
+
+Cursor LogStore::newest(std::size_t n) const {
+    std::size_t seen = 0;
+    for (std::size_t pos = order_.size(); pos-- > 0;) {
+        const std::uint32_t r = sectors_[order_[pos]].records;
+        if (seen + r >= n) return locate(pos, static_cast<std::uint32_t>(r - (n - seen)));
+        seen += r;
+    }
+    return oldest();
+}
+
+Cursor LogStore::seek(std::uint32_t t) const {
+    std::size_t pos = 0;
+    while (pos < order_.size() && (sectors_[order_[pos]].records == 0 || sectors_[order_[pos]].last_ts < t)) ++pos;
+    if (pos == order_.size()) return {pos, kSectorHeader};
+
+    // Start from the last checkpoint before t, then walk at most one stride.
+    const std::uint32_t s = order_[pos];
+    const Checkpoint* cp = &checkpoints_[std::size_t{s} * checkpoints_per_sector_];
+    std::uint32_t off = kSectorHeader;
+    for (std::uint32_t i = 0; i < sectors_[s].checkpoints && cp[i].timestamp < t; ++i) off = cp[i].offset;
+    const std::uint8_t* base = sector_base(s);
+    while (load32(base + off + 4) < t) off += record_size(load16(base + off));
+    return {pos, off};
+}
+
+bool LogStore::next(Cursor& c, Entry& e) const {
+    for (; c.pos < order_.size(); ++c.pos, c.offset = kSectorHeader) {
+        const std::uint32_t s = order_[c.pos];
+        if (c.offset >= sectors_[s].end) continue;
+        const std::uint8_t* r = sector_base(s) + c.offset;
+        const std::uint16_t len = load16(r);
+        e.timestamp = load32(r + 4);
+        e.payload = {r + kRecordHeader, len};
+        c.offset += record_size(len);
+        return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+
+std::uint32_t LogStore::min_erases() const {
+    std::uint32_t v = ~std::uint32_t{0};
+    for (const SectorInfo& info : sectors_) v = std::min(v, info.erase_count);
+    return sectors_.empty() ? 0 : v;
+}
+
+std::uint32_t LogStore::max_erases() const {
+    std::uint32_t v = 0;
+    for (const SectorInfo& info : sectors_) v = std::max(v, info.erase_count);
+    return v;
+}
+
+std::size_t LogStore::index_bytes() const {
+    return sectors_.size() * sizeof(SectorInfo) + checkpoints_.size() * sizeof(Checkpoint) +
+           order_.capacity() * sizeof(std::uint32_t);
+}
+
+}  // namespace g7::logstore
@@ -0,0 +1,267 @@
+// Throughput and latency of the streaming pipeline on the Linux host.
+//
+// The chain is the capstone acquisition path: a file-backed source standing
+// in for ADC + DMA, a 32-tap low-pass FIR, a 4:1 FIR decimator, a
+// delta/zig-zag/varint encoder and a checksumming sink.
+//
+//   ./g7_pipeline_bench
+//   ./g7_pipeline_bench --report                # one paced run with the stage report
+//   G7_PIPELINE_INPUT=capture.raw ./g7_pipeline_bench
+//
+// The input is raw little-endian int16 samples; without G7_PIPELINE_INPUT a
+// synthetic vibration recording is written to a temporary file. That the
+// zero-copy chain and the copying baseline produce the same bytes is checked
+// by g7_pipeline_test.
+//
+// Counters: items_per_second is input samples/s, cycles/sample is measured
+// with g7::cycles. The paced runs replay the file at range(0) kS/s through
+// a 2-block (ping-pong) or 8-block channel and report latency (us), DMA
+// overruns (% of blocks) and the deepest the ready queue got.
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "g7/cycles.hpp"
+#include "g7/dsp.hpp"
+#include "g7/pipeline.hpp"
+#include "chains.hpp"
+
+using namespace g7::pipeline::test;
+
+namespace {
+
+std::string g_input;
+
+bool open_input(pl::FileSource& src, bool loop) {
+    std::string error;
+    if (!src.open(g_input, loop, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+    return true;
+}
+
+void set_cycles_per_sample(benchmark::State& state, std::uint64_t cycles, std::int64_t samples) {
+    state.counters["cycles/sample"] =
+        benchmark::Counter(static_cast<double>(cycles) / static_cast<double>(samples ? samples : 1));
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+
+// Source, stages and sink on one thread: pure framework + kernel cost.
+void BM_ZeroCopyInline(benchmark::State& state) {
+    pl::FileSource src;
+    if (!open_input(src, true)) {
+        state.SkipWithError("no input");
+        return;
+    }
+    auto z = std::make_unique<ZeroCopy<2>>();
+    auto pipe = ZeroCopy<2>::make(*z);
+    auto fill = src.filler<q15_t>();
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        z->ch.transfer(fill);
+        pipe.drain(z->ch);
+    }
+    const auto samples = static_cast<std::int64_t>(state.iterations() * kBlockLen);
+    set_cycles_per_sample(state, g7::cycles::now() - c0, samples);
+    state.SetItemsProcessed(samples);
+    benchmark::DoNotOptimize(z->sum.hash);
+}
+BENCHMARK(BM_ZeroCopyInline);
+
+void BM_CopyingInline(benchmark::State& state) {
+    pl::FileSource src;
+    if (!open_input(src, true)) {
+        state.SkipWithError("no input");
+        return;
+    }
+    Copying c;
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        std::vector<q15_t> raw(kBlockLen);
+        src.read(raw.data(), raw.size());
+        c.push(raw);
+    }
+    const auto samples = static_cast<std::int64_t>(state.iterations() * kBlockLen);
+    set_cycles_per_sample(state, g7::cycles::now() - c0, samples);
+    state.SetItemsProcessed(samples);
+    benchmark::DoNotOptimize(c.sum.hash);
+}
+BENCHMARK(BM_CopyingInline);
+
+// Cheap stages (offset removal, gain, sum) where moving the data costs as
+// much as processing it: this is the framework overhead against a copy per
+// stage.
+void BM_ZeroCopyLight(benchmark::State& state) {
+    pl::FileSource src;
+    if (!open_input(src, true)) {
+        state.SkipWithError("no input");
+        return;
+    }
+    auto ch = std::make_unique<pl::DmaChannel<q15_t, kBlockLen, 2>>();
+    std::int64_t acc = 0;
+    auto pipe = pl::make_pipeline(
+        pl::in_place([](std::span<q15_t> s) {
+            for (q15_t& v : s) v = static_cast<q15_t>(v - 100);
+        }),
+        pl::in_place([](std::span<q15_t> s) {
+            for (q15_t& v : s) v = static_cast<q15_t>(v >> 1);
+        }),
+        pl::sink([&acc](std::span<const q15_t> s) {
+            for (q15_t v : s) acc += v;
+        }));
+    auto fill = src.filler<q15_t>();
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        ch->transfer(fill);
+        pipe.drain(*ch);
+    }
+    const auto samples = static_cast<std::int64_t>(state.iterations() * kBlockLen);
+    set_cycles_per_sample(state, g7::cycles::now() - c0, samples);
+    state.SetItemsProcessed(samples);
+    benchmark::DoNotOptimize(acc);
+}
+BENCHMARK(BM_ZeroCopyLight);
+
+void BM_CopyingLight(benchmark::State& state) {
+    pl::FileSource src;
+    if (!open_input(src, true)) {
+        state.SkipWithError("no input");
+        return;
+    }
+    std::int64_t acc = 0;
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        std::vector<q15_t> raw(kBlockLen);
+        src.read(raw.data(), raw.size());
+        std::vector<q15_t> centred(raw.size());
+        for (std::size_t i = 0; i < raw.size(); ++i) centred[i] = static_cast<q15_t>(raw[i] - 100);
+        std::vector<q15_t> scaled(centred.size());
+        for (std::size_t i = 0; i < centred.size(); ++i) scaled[i] = static_cast<q15_t>(centred[i] >> 1);
+        for (q15_t v : scaled) acc += v;
+    }
+    const auto samples = static_cast<std::int64_t>(state.iterations() * kBlockLen);
+    set_cycles_per_sample(state, g7::cycles::now() - c0, samples);
+    state.SetItemsProcessed(samples);
+    benchmark::DoNotOptimize(acc);
+}
+BENCHMARK(BM_CopyingLight);
+
+// Result of one paced run: the producer thread replays the file in real
+// time, the calling thread runs the pipeline.
+struct PacedResult {
+    std::uint64_t blocks = 0;
+    std::uint64_t overruns = 0;
+    std::size_t max_depth = 0;
+    double p50_us = 0, p99_us = 0, max_us = 0;
+};
+
+template <std::size_t Count>
+PacedResult run_paced(double rate_sps, std::size_t blocks, bool report) {
+    PacedResult r;
+    pl::FileSource src;
+    if (!open_input(src, true)) return r;
+    auto z = std::make_unique<ZeroCopy<Count>>();
+    auto pipe = ZeroCopy<Count>::template make<g7::Histogram>(*z);
+
+    // The producer sleeps between transfers rather than spinning: a DMA
+    // controller costs the core nothing, and on a single-core host a spinning
+    // producer would starve the pipeline it is meant to measure.
+    const auto period = std::chrono::nanoseconds(static_cast<std::int64_t>(1e9 * kBlockLen / rate_sps));
+    std::thread dma([&] {
+        auto fill = src.filler<q15_t>();
+        static q15_t lost[kBlockLen];
+        auto deadline = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < blocks; ++i) {
+            deadline += period;
+            std::this_thread::sleep_until(deadline);
+            // An overrun loses this block's samples; the file position still
+            // advances, as the ADC keeps converting.
+            if (!z->ch.transfer(fill)) {
+                src.read(lost, kBlockLen);
+            }
+        }
+        z->ch.close();
+    });
+    while (!z->ch.done()) {
+        if (pipe.drain(z->ch) == 0) std::this_thread::yield();
+    }
+    dma.join();
+
+    auto us = [](std::uint64_t t) { return g7::cycles::to_ns(t) / 1e3; };
+    r.blocks = blocks;
+    r.overruns = z->ch.overruns();
+    r.max_depth = z->ch.max_depth();
+    r.p50_us = us(pipe.latency().percentile(50));
+    r.p99_us = us(pipe.latency().percentile(99));
+    r.max_us = us(pipe.latency().max());
+    if (report) {
+        static const char* const kNames[] = {"lowpass", "decimate", "encode", "sink"};
+        std::printf("paced run: %.0f kS/s, %zu blocks of %zu samples, %zu-block ring\n", rate_sps / 1e3, blocks,
+                    kBlockLen, Count);
+        pipe.print_report(stdout, kNames);
+        std::printf("dma: published %llu  overruns %llu  max queue depth %zu/%zu  encoded %llu bytes\n",
+                    static_cast<unsigned long long>(z->ch.published()),
+                    static_cast<unsigned long long>(z->ch.overruns()), z->ch.max_depth(), Count,
+                    static_cast<unsigned long long>(z->sum.bytes));
+    }
+    return r;
+}
+
+// range(0): replay rate in kS/s. One iteration is 2000 blocks.
+template <std::size_t Count>
+void BM_Paced(benchmark::State& state) {
+    constexpr std::size_t kBlocks = 2000;
+    const double rate = static_cast<double>(state.range(0)) * 1e3;
+    PacedResult r;
+    for (auto _ : state) {
+        r = run_paced<Count>(rate, kBlocks, false);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBlocks * kBlockLen));
+    state.counters["p50_us"] = r.p50_us;
+    state.counters["p99_us"] = r.p99_us;
+    state.counters["max_us"] = r.max_us;
+    state.counters["overrun%"] = 100.0 * static_cast<double>(r.overruns) / static_cast<double>(r.blocks);
+    state.counters["max_depth"] = static_cast<double>(r.max_depth);
+}
+BENCHMARK(BM_Paced<2>)->Arg(1000)->Arg(8000)->Arg(64000)->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(1);
+BENCHMARK(BM_Paced<8>)->Arg(1000)->Arg(8000)->Arg(64000)->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(1);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool report = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--report") == 0) report = true;
+    }
+
+    std::string temp;
+    if (const char* env = std::getenv("G7_PIPELINE_INPUT")) {
+        g_input = env;
+    } else {
+        if (!make_synthetic_input(std::size_t{1} << 20, temp)) return 2;
+        g_input = temp;
+    }
+
+    if (report) {
+        run_paced<2>(1e6, 5000, true);
+    } else {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+    }
+    if (!temp.empty()) std::remove(temp.c_str());
+    return 0;
+}
@@ -0,0 +1,7 @@
+// Umbrella header for the streaming pipeline framework.
+#pragma once
+
+#include "g7/pipeline/block.hpp"
+#include "g7/pipeline/channel.hpp"
+#include "g7/pipeline/file_source.hpp"
+#include "g7/pipeline/pipeline.hpp"
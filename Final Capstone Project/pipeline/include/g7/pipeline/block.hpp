@@ -0,0 +1,160 @@
+// Pre-allocated sample blocks with single-owner handles.
+//
+// A BlockPool reserves Count blocks of Len elements up front. acquire()
+// hands one out as a move-only Block; destroying or reset()ing the Block
+// returns it to the pool. Stages pass Blocks along by move, so a sample is
+// written once by the source and never copied between stages.
+//
+// The free list is an SPSC ring: one context acquires (the DMA/ISR side),
+// one context releases (the processing side). A pool used entirely from
+// one thread satisfies that trivially. Across threads, only the releasing
+// side may destroy or reset() a Block; the acquiring side must pass every
+// Block on, or park it itself (see DmaChannel::discard()).
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "g7/spsc_ring.hpp"
+
+namespace g7::pipeline {
+
+template <typename T>
+class Block {
+public:
+    using value_type = T;
+    using ReleaseFn = void (*)(void* owner, std::uint16_t index);
+
+    Block() = default;
+    Block(const Block&) = delete;
+    Block& operator=(const Block&) = delete;
+    Block(Block&& o) noexcept { take(o); }
+    Block& operator=(Block&& o) noexcept {
+        if (this != &o) {
+            reset();
+            take(o);
+        }
+        return *this;
+    }
+    ~Block() { reset(); }
+
+    explicit operator bool() const { return data_ != nullptr; }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    std::span<T> span() { return {data_, size_}; }
+    std::span<const T> span() const { return {data_, size_}; }
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    // Shrinks or grows the valid length within the fixed capacity.
+    void resize(std::size_t n) { size_ = static_cast<std::uint32_t>(n < capacity_ ? n : capacity_); }
+
+    // Sequence number and capture timestamp (g7::cycles) set by the source;
+    // transform stages carry them over to their output blocks.
+    std::uint32_t seq = 0;
+    std::uint64_t stamp = 0;
+
+    // Returns the storage to its pool.
+    void reset() {
+        if (release_ != nullptr) {
+            release_(owner_, index_);
+        }
+        data_ = nullptr;
+        release_ = nullptr;
+        size_ = capacity_ = 0;
+    }
+
+    // Detaches the storage without releasing it; used to pass ownership
+    // through an SPSC queue as a plain index. Pools re-wrap it with adopt().
+    std::uint16_t detach() {
+        release_ = nullptr;
+        data_ = nullptr;
+        return index_;
+    }
+
+private:
+    template <typename, std::size_t, std::size_t>
+    friend class BlockPool;
+
+    Block(T* data, std::size_t capacity, void* owner, ReleaseFn release, std::uint16_t index)
+        : data_(data), size_(static_cast<std::uint32_t>(capacity)),
+          capacity_(static_cast<std::uint32_t>(capacity)), index_(index), owner_(owner), release_(release) {}
+
+    void take(Block& o) {
+        data_ = o.data_;
+        size_ = o.size_;
+        capacity_ = o.capacity_;
+        index_ = o.index_;
+        owner_ = o.owner_;
+        release_ = o.release_;
+        seq = o.seq;
+        stamp = o.stamp;
+        o.data_ = nullptr;
+        o.release_ = nullptr;
+        o.size_ = o.capacity_ = 0;
+    }
+
+    T* data_ = nullptr;
+    std::uint32_t size_ = 0;
+    std::uint32_t capacity_ = 0;
+    std::uint16_t index_ = 0;
+    void* owner_ = nullptr;
+    ReleaseFn release_ = nullptr;
+};
+
+namespace detail {
+constexpr std::size_t ring_size(std::size_t n) {
+    std::size_t r = 2;
+    while (r < n) r <<= 1;
+    return r;
+}
+}  // namespace detail
+
+template <typename T, std::size_t Len, std::size_t Count>
+class BlockPool {
+    static_assert(Count >= 2 && Count <= 65535, "a pool needs at least two blocks to ping-pong");
+
+public:
+    using value_type = T;
+    using block_type = Block<T>;
+    static constexpr std::size_t kBlockLen = Len;
+    static constexpr std::size_t kCount = Count;
+
+    BlockPool() {
+        for (std::size_t i = 0; i < Count; ++i) {
+            free_.push(static_cast<std::uint16_t>(i));
+        }
+    }
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    // Empty Block when every block is in flight.
+    Block<T> acquire() {
+        std::uint16_t idx;
+        if (!free_.pop(idx)) {
+            ++exhausted_;
+            return {};
+        }
+        return adopt(idx);
+    }
+
+    // Re-wraps a detached index as an owning Block of full capacity.
+    Block<T> adopt(std::uint16_t idx) { return Block<T>(storage_[idx], Len, this, &release, idx); }
+
+    std::size_t available() const { return free_.size(); }
+    // acquire() calls that found the pool empty.
+    std::uint64_t exhausted() const { return exhausted_; }
+
+private:
+    static void release(void* self, std::uint16_t idx) { static_cast<BlockPool*>(self)->free_.push(idx); }
+
+    alignas(64) T storage_[Count][Len];
+    SpscRing<std::uint16_t, detail::ring_size(Count)> free_;
+    std::uint64_t exhausted_ = 0;
+};
+
+}  // namespace g7::pipeline
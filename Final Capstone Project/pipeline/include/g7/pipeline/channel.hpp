@@ -0,0 +1,145 @@
+// DMA-style block channel between an acquisition context and the pipeline.
+//
+// The producer (a DMA completion ISR on target, a thread or a loop on the
+// host) acquires an empty block, fills it and publishes it; the consumer
+// takes filled blocks in order. Only block indices cross the queue, so
+// handing over a block costs the same whatever its size. With Count == 2
+// this is the classic ping-pong: one block is being filled while the other
+// is being processed.
+//
+// Backpressure is accounted, never hidden: if the producer finds no free
+// block the transfer has nowhere to land and is counted as an overrun,
+// exactly as a real DMA controller would lose it.
+//
+// Only the consumer may drop a Block. Dropping one releases it onto the
+// pool's free list, whose push end belongs to the consumer. A producer that
+// acquired a block and has nothing to publish gives it back with discard().
+// The channel keeps it for the next acquire().
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/cycles.hpp"
+#include "g7/pipeline/block.hpp"
+#include "g7/spsc_ring.hpp"
+
+namespace g7::pipeline {
+
+template <typename T, std::size_t Len, std::size_t Count>
+class DmaChannel {
+public:
+    using value_type = T;
+    using block_type = Block<T>;
+    static constexpr std::size_t kBlockLen = Len;
+    static constexpr std::size_t kCount = Count;
+
+    // -- Producer side -------------------------------------------------------
+
+    // Empty Block (and one overrun counted) when every block is still queued
+    // or being processed.
+    Block<T> acquire() {
+        if (spare_count_ > 0) {
+            return pool_.adopt(spare_[--spare_count_]);
+        }
+        Block<T> b = pool_.acquire();
+        if (!b) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return b;
+    }
+
+    // Stamps `b` with the next sequence number and the current cycle count
+    // and queues it for the consumer.
+    void publish(Block<T>&& b) {
+        Desc d{static_cast<std::uint32_t>(b.size()), seq_++, g7::cycles::now(), b.detach()};
+        // The ready queue is as deep as the pool, so it cannot be full.
+        ready_.push(d);
+        const std::size_t depth = ready_.size();
+        if (depth > max_depth_.load(std::memory_order_relaxed)) {
+            max_depth_.store(depth, std::memory_order_relaxed);
+        }
+        published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns an unpublished block from acquire() to the producer side. It
+    // is not released to the pool, because that would push onto the
+    // consumer's end of the free list.
+    void discard(Block<T>&& b) {
+        if (b) {
+            spare_[spare_count_++] = b.detach();
+        }
+    }
+
+    // Acquire, fill and publish in one call. `fill(T* dst, size_t cap)`
+    // returns the number of elements written; on 0 the block is discard()ed
+    // unpublished. Returns false on overrun or when fill() produced nothing.
+    template <typename Fill>
+    bool transfer(Fill&& fill) {
+        Block<T> b = acquire();
+        if (!b) {
+            return false;
+        }
+        const std::size_t n = fill(b.data(), b.capacity());
+        if (n == 0) {
+            discard(std::move(b));
+            return false;
+        }
+        b.resize(n);
+        publish(std::move(b));
+        return true;
+    }
+
+    // Marks the end of the stream; the consumer sees done() once drained.
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    // -- Consumer side -------------------------------------------------------
+
+    // Oldest filled block, or an empty Block when none is ready.
+    Block<T> take() {
+        Desc d;
+        if (!ready_.pop(d)) {
+            return {};
+        }
+        Block<T> b = pool_.adopt(d.index);
+        b.resize(d.size);
+        b.seq = d.seq;
+        b.stamp = d.stamp;
+        return b;
+    }
+
+    bool done() const { return closed_.load(std::memory_order_acquire) && ready_.empty(); }
+
+    // -- Accounting ----------------------------------------------------------
+
+    std::uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    std::uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+    // Deepest the ready queue has been; Count means the consumer fell a full
+    // pool behind at least once.
+    std::size_t max_depth() const { return max_depth_.load(std::memory_order_relaxed); }
+    // Blocks on the pool's free list; excludes discarded ones held for the
+    // producer.
+    std::size_t free_blocks() const { return pool_.available(); }
+
+private:
+    struct Desc {
+        std::uint32_t size;
+        std::uint32_t seq;
+        std::uint64_t stamp;
+        std::uint16_t index;
+    };
+
+    BlockPool<T, Len, Count> pool_;
+    SpscRing<Desc, detail::ring_size(Count)> ready_;
+    std::uint32_t seq_ = 0;
+    // Producer-side only, like seq_.
+    std::uint16_t spare_[Count] = {};
+    std::size_t spare_count_ = 0;
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> overruns_{0};
+    std::atomic<std::size_t> max_depth_{0};
+    std::atomic<bool> closed_{false};
+};
+
+}  // namespace g7::pipeline
@@ -0,0 +1,110 @@
+// File-backed stand-in for an ADC + DMA front end on the Linux host.
+//
+// The file is memory-mapped and read() copies the next n raw elements into
+// a block, which is the one copy a DMA controller would make on target. With
+// loop enabled the source wraps at end of file, so a short recording can
+// feed an arbitrarily long run. POSIX only.
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace g7::pipeline {
+
+class FileSource {
+public:
+    FileSource() = default;
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+    ~FileSource() { close(); }
+
+    // Maps `path`. Returns false and sets `error` if it cannot be opened or
+    // is empty.
+    bool open(const std::string& path, bool loop, std::string& error) {
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "cannot open " + path;
+            return false;
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            error = path + ": empty or unreadable";
+            return false;
+        }
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            error = path + ": mmap failed";
+            return false;
+        }
+        base_ = static_cast<const unsigned char*>(p);
+        size_ = static_cast<std::size_t>(st.st_size);
+        pos_ = 0;
+        loop_ = loop;
+        return true;
+    }
+
+    void close() {
+        if (base_ != nullptr) {
+            ::munmap(const_cast<unsigned char*>(base_), size_);
+        }
+        base_ = nullptr;
+        size_ = pos_ = 0;
+    }
+
+    // Copies up to n whole elements into dst and returns how many. Fewer
+    // than n (possibly 0) only at end of file without loop; a trailing
+    // partial element is ignored.
+    template <typename T>
+    std::size_t read(T* dst, std::size_t n) {
+        const std::size_t usable = size_ - size_ % sizeof(T);
+        if (usable == 0) {
+            return 0;
+        }
+        auto* out = reinterpret_cast<unsigned char*>(dst);
+        std::size_t want = n * sizeof(T);
+        std::size_t done = 0;
+        while (want > 0) {
+            if (pos_ >= usable) {
+                if (!loop_) {
+                    break;
+                }
+                pos_ = 0;
+                ++wraps_;
+            }
+            const std::size_t chunk = want < usable - pos_ ? want : usable - pos_;
+            std::memcpy(out + done, base_ + pos_, chunk);
+            pos_ += chunk;
+            done += chunk;
+            want -= chunk;
+        }
+        return done / sizeof(T);
+    }
+
+    // Function object for DmaChannel::transfer().
+    template <typename T>
+    auto filler() {
+        return [this](T* dst, std::size_t n) { return read(dst, n); };
+    }
+
+    bool is_open() const { return base_ != nullptr; }
+    std::size_t size_bytes() const { return size_; }
+    std::size_t wraps() const { return wraps_; }
+
+private:
+    const unsigned char* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+    std::size_t wraps_ = 0;
+    bool loop_ = false;
+};
+
+}  // namespace g7::pipeline
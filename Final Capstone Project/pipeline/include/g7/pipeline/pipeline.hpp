@@ -0,0 +1,250 @@
+// Compile-time composed stage graph.
+//
+//   auto pipe = g7::pipeline::make_pipeline(
+//       in_place([&](std::span<q15_t> s) { dsp::fir(lp, s.data(), s.data(), s.size()); }),
+//       transform(bytes, encode),           // Block<q15_t> -> Block<uint8_t>
+//       sink([&](std::span<const uint8_t> s) { uart_write(s); }));
+//   while (auto b = channel.take()) pipe.push(std::move(b));
+//
+// Pipeline<Stages...> stores its stages by value in a tuple and walks them
+// with if constexpr, so every stage call is a direct call the compiler can
+// inline; there is no virtual dispatch and no type erasure.
+//
+// A stage is any object callable with a Block<T> by value:
+//   - returning Block<U> passes that block on (it may be the same block);
+//   - returning an empty Block drops the block at this stage, which is
+//     counted as backpressure (usually its output pool was exhausted);
+//   - returning void ends the chain and must be the last stage (a sink).
+// Blocks a stage does not pass on go back to their pool when it returns.
+//
+// Per-stage counters and the end-to-end latency (from DmaChannel::publish
+// to the return of the last stage, in g7::cycles ticks) are kept for reports.
+// The latency recorder is the first template argument of make_pipeline():
+// g7::CycleStat (count, min, mean, max; 40 bytes) by default, or
+// g7::Histogram for percentiles in host reports, which costs ~8 KB per
+// pipeline and is not meant for the device build:
+//
+//   auto pipe = make_pipeline<g7::Histogram>(stage1, stage2, ...);
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "g7/cycles.hpp"
+#include "g7/histogram.hpp"
+#include "g7/pipeline/block.hpp"
+
+namespace g7::pipeline {
+
+// ---------------------------------------------------------------------------
+// Stage adapters
+
+// Works on the block in place: fn(std::span<T>) or fn(Block<T>&), the latter
+// when the stage changes the length (a decimator, say).
+template <typename F>
+struct InPlace {
+    F fn;
+
+    template <typename T>
+    Block<T> operator()(Block<T> b) {
+        if constexpr (std::is_invocable_v<F&, Block<T>&>) {
+            fn(b);
+        } else {
+            fn(b.span());
+        }
+        return b;
+    }
+};
+
+// Produces a block of another type from `pool`: fn(const Block<In>&,
+// Block<Out>&) fills the output and resize()s it. The input block is
+// released as soon as the stage returns. Sequence number and timestamp are
+// carried over.
+template <typename Pool, typename F>
+struct Transform {
+    Pool* pool;
+    F fn;
+
+    template <typename T>
+    Block<typename Pool::value_type> operator()(Block<T> in) {
+        Block<typename Pool::value_type> out = pool->acquire();
+        if (out) {
+            fn(static_cast<const Block<T>&>(in), out);
+            out.seq = in.seq;
+            out.stamp = in.stamp;
+        }
+        return out;
+    }
+};
+
+// Terminal stage: fn(std::span<const T>) or fn(const Block<T>&).
+template <typename F>
+struct Sink {
+    F fn;
+
+    template <typename T>
+    void operator()(Block<T> b) {
+        if constexpr (std::is_invocable_v<F&, const Block<T>&>) {
+            fn(static_cast<const Block<T>&>(b));
+        } else {
+            fn(std::span<const T>(b.span()));
+        }
+    }
+};
+
+template <typename F>
+InPlace<F> in_place(F fn) {
+    return {std::move(fn)};
+}
+
+template <typename Pool, typename F>
+Transform<Pool, F> transform(Pool& pool, F fn) {
+    return {&pool, std::move(fn)};
+}
+
+template <typename F>
+Sink<F> sink(F fn) {
+    return {std::move(fn)};
+}
+
+// ---------------------------------------------------------------------------
+// Pipeline
+
+struct StageStats {
+    std::uint64_t blocks = 0;   // blocks that entered the stage
+    std::uint64_t dropped = 0;  // blocks the stage did not pass on
+    std::uint64_t cycles = 0;   // time spent inside the stage
+};
+
+// `Latency` is anything with add(std::uint64_t) and reset().
+template <typename Latency, typename... Stages>
+class Pipeline {
+    static_assert(sizeof...(Stages) >= 1, "a pipeline needs at least one stage");
+
+public:
+    static constexpr std::size_t kStages = sizeof...(Stages);
+
+    explicit Pipeline(Stages... stages) : stages_(std::move(stages)...) {}
+
+    // Runs one block through every stage. Returns false if a stage dropped it.
+    template <typename T>
+    bool push(Block<T>&& b) {
+        const std::uint64_t stamp = b.stamp;
+        return run<0>(std::move(b), stamp);
+    }
+
+    // Pushes every block the channel has ready; returns how many were taken.
+    template <typename Channel>
+    std::size_t drain(Channel& ch) {
+        std::size_t n = 0;
+        while (auto b = ch.take()) {
+            push(std::move(b));
+            ++n;
+        }
+        return n;
+    }
+
+    template <std::size_t I>
+    auto& stage() {
+        return std::get<I>(stages_);
+    }
+
+    const StageStats& stats(std::size_t i) const { return stats_[i]; }
+    std::uint64_t delivered() const { return delivered_; }
+    std::uint64_t dropped() const {
+        std::uint64_t n = 0;
+        for (const StageStats& s : stats_) n += s.dropped;
+        return n;
+    }
+    // End-to-end latency of delivered, timestamped blocks, in g7::cycles ticks.
+    const Latency& latency() const { return latency_; }
+
+    void reset_stats() {
+        for (StageStats& s : stats_) s = StageStats{};
+        delivered_ = 0;
+        latency_.reset();
+    }
+
+    // One line per stage plus the latency summary, in microseconds.
+    void print_report(std::FILE* out, const char* const* names = nullptr) const {
+        std::fprintf(out, "%-12s %10s %8s %12s\n", "stage", "blocks", "dropped", "us/block");
+        for (std::size_t i = 0; i < kStages; ++i) {
+            const StageStats& s = stats_[i];
+            const double us = s.blocks ? cycles::to_ns(s.cycles) / 1e3 / static_cast<double>(s.blocks) : 0.0;
+            if (names != nullptr) {
+                std::fprintf(out, "%-12s", names[i]);
+            } else {
+                std::fprintf(out, "%-12zu", i);
+            }
+            std::fprintf(out, " %10llu %8llu %12.3f\n", static_cast<unsigned long long>(s.blocks),
+                         static_cast<unsigned long long>(s.dropped), us);
+        }
+        auto us = [](std::uint64_t t) { return cycles::to_ns(t) / 1e3; };
+        if constexpr (std::is_same_v<Latency, Histogram>) {
+            std::fprintf(out, "latency us: p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f  (%llu blocks)\n",
+                         us(latency_.percentile(50)), us(latency_.percentile(99)), us(latency_.percentile(99.9)),
+                         us(latency_.max()), static_cast<unsigned long long>(latency_.count()));
+        } else if constexpr (std::is_same_v<Latency, CycleStat>) {
+            std::fprintf(out, "latency us: mean %.1f  max %.1f  (%llu blocks)\n", us(static_cast<std::uint64_t>(latency_.mean())),
+                         us(latency_.max), static_cast<unsigned long long>(latency_.count));
+        }
+    }
+
+private:
+    template <std::size_t I, typename T>
+    bool run(Block<T>&& b, std::uint64_t stamp) {
+        StageStats& st = stats_[I];
+        ++st.blocks;
+        auto& stage = std::get<I>(stages_);
+        using R = decltype(stage(std::move(b)));
+        const std::uint64_t t0 = cycles::now();
+        if constexpr (std::is_void_v<R>) {
+            static_assert(I + 1 == kStages, "only the last stage may return void");
+            stage(std::move(b));
+            finish(st, t0, stamp);
+            return true;
+        } else {
+            R out = stage(std::move(b));
+            if (!out) {
+                st.cycles += cycles::now() - t0;
+                ++st.dropped;
+                return false;
+            }
+            if constexpr (I + 1 == kStages) {
+                out.reset();
+                finish(st, t0, stamp);
+                return true;
+            } else {
+                st.cycles += cycles::now() - t0;
+                return run<I + 1>(std::move(out), stamp);
+            }
+        }
+    }
+
+    void finish(StageStats& st, std::uint64_t t0, std::uint64_t stamp) {
+        const std::uint64_t t1 = cycles::now();
+        st.cycles += t1 - t0;
+        // Blocks that did not come through a DmaChannel carry no timestamp.
+        if (stamp != 0) {
+            latency_.add(t1 - stamp);
+        }
+        ++delivered_;
+    }
+
+    std::tuple<Stages...> stages_;
+    StageStats stats_[kStages] = {};
+    std::uint64_t delivered_ = 0;
+    Latency latency_;
+};
+
+template <typename Latency = CycleStat, typename... Stages>
+Pipeline<Latency, Stages...> make_pipeline(Stages... stages) {
+    return Pipeline<Latency, Stages...>(std::move(stages)...);
+}
+
+}  // namespace g7::pipeline
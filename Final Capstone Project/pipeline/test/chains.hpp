@@ -0,0 +1,170 @@
+// The capstone acquisition chain, built twice: on the zero-copy pipeline and
+// as a copying std::vector baseline. Shared by the pipeline test and
+// benchmarks.
+#pragma once
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "g7/dsp.hpp"
+#include "g7/pipeline.hpp"
+
+namespace g7::pipeline::test {
+
+namespace dsp = g7::dsp;
+namespace pl = g7::pipeline;
+using dsp::q15_t;
+
+inline constexpr std::size_t kBlockLen = 1024;
+inline constexpr std::size_t kTaps = 32;
+inline constexpr std::uint8_t kDecim = 4;
+// Worst case is three varint bytes per decimated sample.
+inline constexpr std::size_t kEncodedLen = kBlockLen / kDecim * 3;
+
+// ---------------------------------------------------------------------------
+// Input
+
+// Two tones plus noise, loosely a motor vibration capture at 1 MS/s.
+inline bool write_synthetic(const std::string& path, std::size_t samples) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) return false;
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 600.0);
+    std::vector<q15_t> buf(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        const double t = static_cast<double>(i) * 1e-6;
+        const double v = 9000.0 * std::sin(2 * M_PI * 1170.0 * t) + 4000.0 * std::sin(2 * M_PI * 41500.0 * t) +
+                         noise(rng);
+        buf[i] = dsp::sat_q15(static_cast<std::int32_t>(std::lround(v)));
+    }
+    const bool ok = std::fwrite(buf.data(), sizeof(q15_t), samples, f) == samples;
+    return std::fclose(f) == 0 && ok;
+}
+
+// Writes `samples` synthetic samples to a new temporary file and sets `path`.
+// The caller removes it.
+inline bool make_synthetic_input(std::size_t samples, std::string& path) {
+    char name[] = "/tmp/g7_pipeline_XXXXXX";
+    const int fd = mkstemp(name);
+    if (fd < 0) {
+        std::fprintf(stderr, "cannot create temporary input\n");
+        return false;
+    }
+    close(fd);
+    path = name;
+    if (!write_synthetic(path, samples)) {
+        std::fprintf(stderr, "cannot write %s\n", path.c_str());
+        std::remove(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Stage kernels shared by both chains
+
+inline std::vector<q15_t> lowpass(std::size_t taps, double cutoff) {
+    std::vector<q15_t> c(taps);
+    dsp::fir_lowpass_q15(c.data(), taps, cutoff);
+    return c;
+}
+
+// Filter instances and their state; one per chain so each starts clean.
+struct Filters {
+    std::vector<q15_t> lp_coeffs = lowpass(kTaps, 0.2);
+    std::vector<q15_t> aa_coeffs = lowpass(kTaps, 0.5 / kDecim);
+    std::vector<q15_t> lp_state = std::vector<q15_t>(kTaps - 1 + kBlockLen);
+    std::vector<q15_t> aa_state = std::vector<q15_t>(kTaps - 1 + kBlockLen);
+    dsp::FirQ15 lp;
+    dsp::FirDecimateQ15 aa;
+    q15_t prev = 0;  // encoder delta reference
+
+    Filters() {
+        lp.init(kTaps, lp_coeffs.data(), lp_state.data(), kBlockLen);
+        aa.init(kTaps, kDecim, aa_coeffs.data(), aa_state.data(), kBlockLen);
+    }
+};
+
+// Delta, zig-zag, LEB128. Returns bytes written.
+inline std::size_t encode(const q15_t* in, std::size_t n, q15_t& prev, std::uint8_t* out) {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::int32_t d = static_cast<std::int32_t>(in[i]) - prev;
+        prev = in[i];
+        auto z = static_cast<std::uint32_t>((d << 1) ^ (d >> 31));
+        while (z >= 0x80) {
+            out[k++] = static_cast<std::uint8_t>(z | 0x80);
+            z >>= 7;
+        }
+        out[k++] = static_cast<std::uint8_t>(z);
+    }
+    return k;
+}
+
+// FNV-1a over everything the sink sees.
+struct Checksum {
+    std::uint64_t hash = 1469598103934665603ull;
+    std::uint64_t bytes = 0;
+
+    void add(const std::uint8_t* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) hash = (hash ^ p[i]) * 1099511628211ull;
+        bytes += n;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Zero-copy chain
+
+template <std::size_t Count>
+struct ZeroCopy {
+    using Channel = pl::DmaChannel<q15_t, kBlockLen, Count>;
+    using BytePool = pl::BlockPool<std::uint8_t, kEncodedLen, 4>;
+
+    Filters f;
+    Checksum sum;
+    BytePool bytes;
+    Channel ch;
+
+    template <typename Latency = g7::CycleStat>
+    static auto make(ZeroCopy& z) {
+        return pl::make_pipeline<Latency>(
+            pl::in_place([&z](std::span<q15_t> s) { dsp::fir(z.f.lp, s.data(), s.data(), s.size()); }),
+            pl::in_place([&z](pl::Block<q15_t>& b) {
+                dsp::fir_decimate(z.f.aa, b.data(), b.data(), b.size());
+                b.resize(b.size() / kDecim);
+            }),
+            pl::transform(z.bytes,
+                          [&z](const pl::Block<q15_t>& in, pl::Block<std::uint8_t>& out) {
+                              out.resize(encode(in.data(), in.size(), z.f.prev, out.data()));
+                          }),
+            pl::sink([&z](std::span<const std::uint8_t> s) { z.sum.add(s.data(), s.size()); }));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Copying baseline: every stage returns a fresh vector, as a straightforward
+// std::vector-based pipeline would.
+
+struct Copying {
+    Filters f;
+    Checksum sum;
+
+    void push(const std::vector<q15_t>& raw) {
+        std::vector<q15_t> filtered(raw.size());
+        dsp::fir(f.lp, raw.data(), filtered.data(), raw.size());
+        std::vector<q15_t> decimated(filtered.size() / kDecim);
+        dsp::fir_decimate(f.aa, filtered.data(), decimated.data(), filtered.size());
+        std::vector<std::uint8_t> encoded(decimated.size() * 3);
+        encoded.resize(encode(decimated.data(), decimated.size(), f.prev, encoded.data()));
+        sum.add(encoded.data(), encoded.size());
+    }
+};
+
+}  // namespace g7::pipeline::test
@@ -0,0 +1,7 @@
+// Umbrella header for the telemetry format.
+#pragma once
+
+#include "g7/telemetry/decoder.hpp"
+#include "g7/telemetry/encoder.hpp"
+#include "g7/telemetry/schema.hpp"
+#include "g7/telemetry/wire.hpp"
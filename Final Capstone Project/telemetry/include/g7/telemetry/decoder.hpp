@@ -0,0 +1,80 @@
+// Host-side streaming decoder.
+//
+//   g7::telemetry::Decoder dec([](const g7::telemetry::Record& r) { ... });
+//   dec.add_schema(kNode.view());
+//   while (int n = read(uart_fd, buf, sizeof(buf)); n > 0) dec.feed(buf, n);
+//
+// feed() accepts any chunking of the byte stream: a frame split across
+// reads is buffered until complete, and several frames in one read are all
+// decoded. Noise between frames, a bad CRC or an unknown schema costs one
+// byte of resync; the decoder then scans for the next sync byte. Records are
+// delivered in stream order through the callback, and only once their whole
+// frame has decoded: a malformed payload delivers nothing.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "g7/telemetry/schema.hpp"
+#include "g7/telemetry/wire.hpp"
+
+namespace g7::telemetry {
+
+struct Record {
+    const SchemaView* schema = nullptr;
+    std::uint32_t timestamp = 0;
+    std::uint32_t present = 0;  // bit i set if field i was sent
+    std::int32_t values[kMaxFields] = {};
+
+    bool has(std::size_t i) const { return ((present >> i) & 1u) != 0; }
+};
+
+struct DecoderStats {
+    std::uint64_t frames = 0;
+    std::uint64_t records = 0;
+    std::uint64_t crc_errors = 0;
+    std::uint64_t bad_frames = 0;     // unknown schema, oversize or malformed payload
+    std::uint64_t skipped_bytes = 0;  // bytes discarded while resyncing
+};
+
+// Decodes the `count` records of one frame payload against `s` into `out`,
+// which must have room for them. Returns false if the payload is truncated
+// or has bytes left over; `out` then holds a partial decode and must not be
+// used.
+bool decode_payload(const SchemaView& s, const std::uint8_t* payload, std::size_t len, std::size_t count,
+                    Record* out);
+
+class Decoder {
+public:
+    using Callback = std::function<void(const Record&)>;
+
+    explicit Decoder(Callback on_record, std::size_t max_payload = 4096);
+
+    // Registers a schema by id. The view is copied; its field array must
+    // outlive the decoder, as a constexpr schema's does. Returns false if the
+    // id is already taken.
+    bool add_schema(const SchemaView& s);
+
+    void feed(const std::uint8_t* data, std::size_t n);
+
+    // Bytes held back waiting for the rest of a frame.
+    std::size_t buffered() const { return buf_.size() - head_; }
+    const DecoderStats& stats() const { return stats_; }
+
+private:
+    // The header's record count is one byte.
+    static constexpr std::size_t kMaxRecords = 255;
+
+    Callback on_record_;
+    std::size_t max_payload_;
+    std::vector<Record> records_;  // one frame, decoded before delivery
+    SchemaView schemas_[256] = {};
+    bool known_[256] = {};
+    std::vector<std::uint8_t> buf_;
+    std::size_t head_ = 0;
+    DecoderStats stats_;
+};
+
+}  // namespace g7::telemetry
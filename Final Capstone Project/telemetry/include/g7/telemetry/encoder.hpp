@@ -0,0 +1,152 @@
+// Device-side frame encoder.
+//
+//   std::uint8_t frame[96];                       // one LoRa payload
+//   g7::telemetry::Encoder<kNode> enc(frame, sizeof(frame));
+//   if (!enc.add(t_ms, {vib, accel, clip, seq}, present)) {
+//       radio_send(enc.finish());
+//       enc.add(t_ms, {vib, accel, clip, seq}, present);
+//   }
+//
+// The schema is a template argument, so field loops run over constants and
+// the encoder does no allocation and keeps no per-field metadata at run
+// time. Records go straight into the caller's buffer; finish() writes the
+// header and CRC in place and returns the frame, which stays valid until
+// the next add().
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "g7/telemetry/schema.hpp"
+#include "g7/telemetry/wire.hpp"
+
+namespace g7::telemetry {
+
+template <const auto& S>
+class Encoder {
+    using SchemaType = std::remove_cvref_t<decltype(S)>;
+    static_assert(S.valid(), "invalid telemetry schema");
+
+public:
+    static constexpr std::size_t kFields = SchemaType::kFields;
+    static constexpr std::size_t kMaxRecord = S.max_record_bytes();
+    // Smallest buffer that can hold a frame of one worst-case record.
+    static constexpr std::size_t kMinBuffer = kHeaderBytes + kMaxRecord + kTrailerBytes;
+    static constexpr std::uint32_t kAllPresent = ~std::uint32_t{0};
+    using Values = std::array<std::int32_t, kFields>;
+
+    Encoder(std::uint8_t* buf, std::size_t cap)
+        : buf_(buf), cap_(cap < kHeaderBytes + 0xFFFF + kTrailerBytes ? cap : kHeaderBytes + 0xFFFF + kTrailerBytes) {
+        reset();
+    }
+
+    // Appends a record. Bit i of `present` marks optional field i as present;
+    // it is ignored for required fields. Returns false, leaving the frame
+    // unchanged, when the record does not fit: finish() and add it again.
+    bool add(std::uint32_t timestamp, const Values& v, std::uint32_t present = kAllPresent) {
+        if (count_ == kMaxRecordsPerFrame) return false;
+        std::uint8_t rec[kMaxRecord];
+        std::uint8_t* p = put_varint(rec, count_ == 0 ? timestamp : timestamp - last_ts_);
+
+        // Bit-packed block: presence bits, then present packed fields.
+        std::uint64_t acc = 0;
+        unsigned nbits = 0;
+        auto put_bits = [&](std::uint32_t value, unsigned width) {
+            acc |= static_cast<std::uint64_t>(value) << nbits;
+            nbits += width;
+            while (nbits >= 8) {
+                *p++ = static_cast<std::uint8_t>(acc);
+                acc >>= 8;
+                nbits -= 8;
+            }
+        };
+        for (std::size_t i = 0; i < kFields; ++i) {
+            if (S.fields[i].optional) put_bits(has(present, i) ? 1u : 0u, 1);
+        }
+        for (std::size_t i = 0; i < kFields; ++i) {
+            const Field& f = S.fields[i];
+            if (f.packed() && has(present, i)) {
+                const std::uint32_t mask = f.width == 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << f.width) - 1;
+                put_bits(static_cast<std::uint32_t>(v[i]) & mask, f.width);
+            }
+        }
+        if (nbits > 0) *p++ = static_cast<std::uint8_t>(acc);
+
+        for (std::size_t i = 0; i < kFields; ++i) {
+            const Field& f = S.fields[i];
+            if (f.packed() || !has(present, i)) continue;
+            switch (f.type) {
+            case FieldType::Varint:
+                p = put_varint(p, static_cast<std::uint32_t>(v[i]));
+                break;
+            case FieldType::ZigZag:
+                p = put_varint(p, zigzag64(v[i]));
+                break;
+            case FieldType::Delta:
+                p = put_varint(p, zigzag64(static_cast<std::int64_t>(v[i]) - prev_[i]));
+                break;
+            default:
+                break;
+            }
+        }
+
+        const auto n = static_cast<std::size_t>(p - rec);
+        if (pos_ + n + kTrailerBytes > cap_) return false;
+        std::memcpy(buf_ + pos_, rec, n);
+        pos_ += n;
+        for (std::size_t i = 0; i < kFields; ++i) {
+            if (S.fields[i].type == FieldType::Delta && has(present, i)) prev_[i] = v[i];
+        }
+        last_ts_ = timestamp;
+        ++count_;
+        return true;
+    }
+
+    // Seals the frame and starts a new one in the same buffer. Empty span if
+    // no record was added.
+    std::span<const std::uint8_t> finish() {
+        if (count_ == 0) return {};
+        const std::size_t len = pos_ - kHeaderBytes;
+        buf_[0] = kSync;
+        buf_[1] = S.id;
+        buf_[2] = static_cast<std::uint8_t>(count_);
+        buf_[3] = static_cast<std::uint8_t>(len);
+        buf_[4] = static_cast<std::uint8_t>(len >> 8);
+        const std::uint16_t crc = crc16(buf_ + 1, pos_ - 1);
+        buf_[pos_] = static_cast<std::uint8_t>(crc);
+        buf_[pos_ + 1] = static_cast<std::uint8_t>(crc >> 8);
+        const std::size_t total = pos_ + kTrailerBytes;
+        reset();
+        return {buf_, total};
+    }
+
+    // Drops the frame in progress.
+    void reset() {
+        pos_ = kHeaderBytes;
+        count_ = 0;
+        last_ts_ = 0;
+        prev_ = {};
+    }
+
+    std::size_t records() const { return count_; }
+    // Bytes the frame would take if finished now.
+    std::size_t size() const { return pos_ + kTrailerBytes; }
+
+private:
+    static constexpr bool has(std::uint32_t present, std::size_t i) {
+        return !S.fields[i].optional || ((present >> i) & 1u) != 0;
+    }
+
+    std::uint8_t* buf_;
+    std::size_t cap_;
+    std::size_t pos_ = kHeaderBytes;
+    std::size_t count_ = 0;
+    std::uint32_t last_ts_ = 0;
+    Values prev_{};
+};
+
+}  // namespace g7::telemetry
@@ -0,0 +1,95 @@
+// Compile-time telemetry schemas.
+//
+//   inline constexpr g7::telemetry::Schema<4> kNode{
+//       0x01, "node",
+//       {{delta("vib"), optional(delta("accel_z")), flag("clip"), bits("seq", 4)}}};
+//   static_assert(kNode.valid());
+//
+// A record is a timestamp plus one int32 value per field. Each field picks its
+// wire encoding:
+//
+//   Varint  unsigned LEB128 (negative values cost 5 bytes)
+//   ZigZag  signed, zig-zag then LEB128
+//   Delta   signed difference from the field's previous value in the same
+//           frame, zig-zag then LEB128; slowly changing signals cost 1 byte
+//   Bits    unsigned, packed into `width` bits (value masked to the width)
+//   SBits   signed two's complement in `width` bits, sign-extended on decode
+//
+// Optional fields carry a presence bit and cost nothing else when absent.
+// Schemas are plain constexpr data: the device-side Encoder takes one as a
+// template argument, the host-side Decoder takes its SchemaView at run time.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace g7::telemetry {
+
+inline constexpr std::size_t kMaxFields = 32;
+
+enum class FieldType : std::uint8_t { Varint, ZigZag, Delta, Bits, SBits };
+
+struct Field {
+    const char* name = "";
+    FieldType type = FieldType::Varint;
+    std::uint8_t width = 0;  // Bits / SBits only, 1..32
+    bool optional = false;
+
+    constexpr bool packed() const { return type == FieldType::Bits || type == FieldType::SBits; }
+};
+
+constexpr Field varint(const char* name) { return {name, FieldType::Varint, 0, false}; }
+constexpr Field zigzag(const char* name) { return {name, FieldType::ZigZag, 0, false}; }
+constexpr Field delta(const char* name) { return {name, FieldType::Delta, 0, false}; }
+constexpr Field bits(const char* name, std::uint8_t width) { return {name, FieldType::Bits, width, false}; }
+constexpr Field sbits(const char* name, std::uint8_t width) { return {name, FieldType::SBits, width, false}; }
+constexpr Field flag(const char* name) { return bits(name, 1); }
+constexpr Field optional(Field f) {
+    f.optional = true;
+    return f;
+}
+
+// Type-erased view for code that handles several schemas at run time.
+struct SchemaView {
+    std::uint8_t id = 0;
+    const char* name = "";
+    const Field* fields = nullptr;
+    std::size_t count = 0;
+};
+
+template <std::size_t N>
+struct Schema {
+    static_assert(N >= 1 && N <= kMaxFields, "a schema has 1..32 fields");
+    static constexpr std::size_t kFields = N;
+
+    std::uint8_t id;
+    const char* name;
+    std::array<Field, N> fields;
+
+    // Bits and SBits widths must be 1..32 and the rest must have none.
+    constexpr bool valid() const {
+        for (const Field& f : fields) {
+            if (f.packed() ? (f.width < 1 || f.width > 32) : f.width != 0) return false;
+        }
+        return true;
+    }
+
+    // Presence bits plus packed field bits, i.e. the bit-packed block size.
+    constexpr std::size_t packed_bits() const {
+        std::size_t n = 0;
+        for (const Field& f : fields) n += (f.optional ? 1u : 0u) + (f.packed() ? f.width : 0u);
+        return n;
+    }
+
+    // Worst-case encoded record size, timestamp included.
+    constexpr std::size_t max_record_bytes() const {
+        std::size_t n = 5 + (packed_bits() + 7) / 8;
+        for (const Field& f : fields) n += f.packed() ? 0 : 5;
+        return n;
+    }
+
+    constexpr SchemaView view() const { return {id, name, fields.data(), N}; }
+};
+
+}  // namespace g7::telemetry
@@ -0,0 +1,58 @@
+// Wire format shared by the encoder and the decoder.
+//
+//   frame   := 0xA5 schema:u8 count:u8 len:u16le payload[len] crc:u16le
+//   payload := record[count]
+//   record  := timestamp:varint packed[ceil(packed_bits / 8)] varint*
+//
+// The CRC is CRC-16/CCITT-FALSE over schema..payload. The timestamp is
+// absolute in the first record of a frame and a delta (mod 2^32) after
+// that. The packed block holds, LSB first, one presence bit per optional
+// field in schema order, then the bits of each present Bits/SBits field. The
+// varints follow, one per present Varint/ZigZag/Delta field, in schema order.
+// Delta state also restarts at each frame. A lost frame therefore never
+// corrupts the next one, and the sync byte plus CRC let a receiver resync in
+// the middle of a byte stream.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace g7::telemetry {
+
+inline constexpr std::uint8_t kSync = 0xA5;
+inline constexpr std::size_t kHeaderBytes = 5;
+inline constexpr std::size_t kTrailerBytes = 2;
+inline constexpr std::size_t kMaxRecordsPerFrame = 255;
+
+std::uint16_t crc16(const std::uint8_t* data, std::size_t n, std::uint16_t crc = 0xFFFF);
+
+inline std::uint64_t zigzag64(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t z) {
+    return static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+}
+
+// Writes LEB128; returns the new end. The caller guarantees room (<= 10 bytes).
+inline std::uint8_t* put_varint(std::uint8_t* p, std::uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = static_cast<std::uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<std::uint8_t>(v);
+    return p;
+}
+
+// Reads LEB128 from [p, end); returns nullptr if truncated or over 64 bits.
+inline const std::uint8_t* get_varint(const std::uint8_t* p, const std::uint8_t* end, std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const std::uint8_t b = *p++;
+        v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) return p;
+    }
+    return nullptr;
+}
+
+}  // namespace g7::telemetry
@@ -0,0 +1,20 @@
+#include "g7/telemetry/wire.hpp"
+
+namespace g7::telemetry {
+
+// CRC-16/CCITT-FALSE (poly 0x1021), a nibble at a time: a 32-byte table is a
+// reasonable middle ground between the bitwise loop and a 512-byte table on
+// a small part.
+std::uint16_t crc16(const std::uint8_t* data, std::size_t n, std::uint16_t crc) {
+    static constexpr std::uint16_t kTable[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    for (std::size_t i = 0; i < n; ++i) {
+        crc = static_cast<std::uint16_t>((crc << 4) ^ kTable[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = static_cast<std::uint16_t>((crc << 4) ^ kTable[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+}  // namespace g7::telemetry
@@ -0,0 +1,156 @@
+#include "g7/telemetry/decoder.hpp"
+
+#include <cstring>
+
+namespace g7::telemetry {
+
+// ---------------------------------------------------------------------------
+// Payload
+
+bool decode_payload(const SchemaView& s, const std::uint8_t* payload, std::size_t len, std::size_t count,
+                    Record* out) {
+    const std::uint8_t* p = payload;
+    const std::uint8_t* const end = payload + len;
+    std::int64_t prev[kMaxFields] = {};
+
+    std::uint64_t acc = 0;
+    unsigned nbits = 0;
+    auto get_bits = [&](unsigned width, std::uint32_t& out) {
+        while (nbits < width) {
+            if (p == end) return false;
+            acc |= static_cast<std::uint64_t>(*p++) << nbits;
+            nbits += 8;
+        }
+        out = static_cast<std::uint32_t>(acc & ((std::uint64_t{1} << width) - 1));
+        acc >>= width;
+        nbits -= width;
+        return true;
+    };
+
+    for (std::size_t k = 0; k < count; ++k) {
+        Record& r = out[k];
+        r.schema = &s;
+        std::uint64_t v;
+        if ((p = get_varint(p, end, v)) == nullptr) return false;
+        r.timestamp = k == 0 ? static_cast<std::uint32_t>(v) : out[k - 1].timestamp + static_cast<std::uint32_t>(v);
+
+        r.present = 0;
+        for (std::size_t i = 0; i < s.count; ++i) {
+            std::uint32_t bit = 1;
+            if (s.fields[i].optional && !get_bits(1, bit)) return false;
+            r.present |= bit << i;
+            r.values[i] = 0;
+        }
+        for (std::size_t i = 0; i < s.count; ++i) {
+            const Field& f = s.fields[i];
+            if (!f.packed() || !r.has(i)) continue;
+            std::uint32_t raw;
+            if (!get_bits(f.width, raw)) return false;
+            if (f.type == FieldType::SBits && f.width < 32 && (raw >> (f.width - 1)) != 0) {
+                raw |= ~std::uint32_t{0} << f.width;
+            }
+            r.values[i] = static_cast<std::int32_t>(raw);
+        }
+        // The packed block ends on a byte boundary.
+        acc = 0;
+        nbits = 0;
+
+        for (std::size_t i = 0; i < s.count; ++i) {
+            const Field& f = s.fields[i];
+            if (f.packed() || !r.has(i)) continue;
+            if ((p = get_varint(p, end, v)) == nullptr) return false;
+            switch (f.type) {
+            case FieldType::Varint:
+                r.values[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(v));
+                break;
+            case FieldType::ZigZag:
+                r.values[i] = static_cast<std::int32_t>(unzigzag(v));
+                break;
+            case FieldType::Delta:
+                prev[i] += unzigzag(v);
+                r.values[i] = static_cast<std::int32_t>(prev[i]);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return p == end;
+}
+
+// ---------------------------------------------------------------------------
+// Stream
+
+Decoder::Decoder(Callback on_record, std::size_t max_payload)
+    : on_record_(std::move(on_record)),
+      max_payload_(max_payload < 0xFFFF ? max_payload : 0xFFFF),
+      records_(kMaxRecords) {}
+
+bool Decoder::add_schema(const SchemaView& s) {
+    if (known_[s.id] || s.count == 0 || s.count > kMaxFields) return false;
+    schemas_[s.id] = s;
+    known_[s.id] = true;
+    return true;
+}
+
+void Decoder::feed(const std::uint8_t* data, std::size_t n) {
+    buf_.insert(buf_.end(), data, data + n);
+    for (;;) {
+        const std::uint8_t* base = buf_.data() + head_;
+        std::size_t avail = buf_.size() - head_;
+        const void* sync = avail ? std::memchr(base, kSync, avail) : nullptr;
+        if (sync == nullptr) {
+            stats_.skipped_bytes += avail;
+            head_ = buf_.size();
+            break;
+        }
+        const auto skip = static_cast<std::size_t>(static_cast<const std::uint8_t*>(sync) - base);
+        stats_.skipped_bytes += skip;
+        head_ += skip;
+        base += skip;
+        avail -= skip;
+        if (avail < kHeaderBytes) break;
+
+        const std::uint8_t id = base[1];
+        const std::size_t count = base[2];
+        const std::size_t len = base[3] | static_cast<std::size_t>(base[4]) << 8;
+        if (!known_[id] || count == 0 || len > max_payload_) {
+            // Most likely a sync byte inside noise or payload: step over it.
+            ++stats_.bad_frames;
+            ++stats_.skipped_bytes;
+            ++head_;
+            continue;
+        }
+        const std::size_t total = kHeaderBytes + len + kTrailerBytes;
+        if (avail < total) break;
+        const std::uint16_t want = crc16(base + 1, kHeaderBytes - 1 + len);
+        const std::uint16_t got = static_cast<std::uint16_t>(base[kHeaderBytes + len] |
+                                                             base[kHeaderBytes + len + 1] << 8);
+        if (want != got) {
+            ++stats_.crc_errors;
+            ++stats_.skipped_bytes;
+            ++head_;
+            continue;
+        }
+        // Nothing is delivered until the whole payload has decoded cleanly.
+        if (decode_payload(schemas_[id], base + kHeaderBytes, len, count, records_.data())) {
+            ++stats_.frames;
+            stats_.records += count;
+            for (std::size_t k = 0; k < count; ++k) on_record_(records_[k]);
+        } else {
+            ++stats_.bad_frames;
+        }
+        head_ += total;
+    }
+
+    // Keep the held-back tail at the front so the buffer stays small.
+    if (head_ == buf_.size()) {
+        buf_.clear();
+        head_ = 0;
+    } else if (head_ >= 4096) {
+        buf_.erase(buf_.begin(), buf_.begin() + static_cast<std::ptrdiff_t>(head_));
+        head_ = 0;
+    }
+}
+
+}  // namespace g7::telemetry
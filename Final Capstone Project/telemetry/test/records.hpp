@@ -0,0 +1,189 @@
+// The telemetry test and benchmark workload: records built from the
+// simulator's recorded traces, the binary framing of them, and the JSON
+// baseline. Shared by the telemetry test and benchmarks.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "g7/telemetry.hpp"
+
+namespace g7::telemetry::test {
+
+namespace tel = g7::telemetry;
+
+
+inline constexpr tel::Schema<4> kNode{
+    0x01, "node", {{tel::delta("vib"), tel::optional(tel::delta("accel_z")), tel::flag("clip"), tel::bits("seq", 4)}}};
+
+enum : std::size_t { kVib, kAccel, kClip, kSeq };
+
+inline constexpr std::size_t kFrameBytes = 96;
+static_assert(kFrameBytes >= tel::Encoder<kNode>::kMinBuffer);
+
+struct Sample {
+    std::uint32_t t = 0;  // ms
+    std::uint32_t present = 0;
+    tel::Encoder<kNode>::Values v{};
+};
+
+// ---------------------------------------------------------------------------
+// Input
+
+inline bool load(std::vector<Sample>& out) {
+    const std::string dir = G7_TELEMETRY_DATA_DIR;
+    std::FILE* vib = std::fopen((dir + "/vibration_adc.csv").c_str(), "r");
+    std::FILE* acc = std::fopen((dir + "/accel_z.csv").c_str(), "r");
+    if (vib == nullptr || acc == nullptr) {
+        std::fprintf(stderr, "cannot open the traces in %s\n", dir.c_str());
+        if (vib) std::fclose(vib);
+        if (acc) std::fclose(acc);
+        return false;
+    }
+
+    std::vector<std::pair<std::uint32_t, int>> accel;
+    char line[128];
+    while (std::fgets(line, sizeof(line), acc)) {
+        double s;
+        int mg;
+        if (std::sscanf(line, "%lf,%d", &s, &mg) == 2) {
+            accel.emplace_back(static_cast<std::uint32_t>(s * 1000.0 + 0.5), mg);
+        }
+    }
+
+    std::size_t next = 0;
+    while (std::fgets(line, sizeof(line), vib)) {
+        if (line[0] == '#') continue;
+        Sample s;
+        s.t = static_cast<std::uint32_t>(out.size());
+        s.v[kVib] = std::atoi(line);
+        s.v[kClip] = s.v[kVib] <= 0 || s.v[kVib] >= 4095;
+        s.v[kSeq] = static_cast<std::int32_t>(out.size() & 15);
+        s.present = 0;
+        if (next < accel.size() && accel[next].first <= s.t) {
+            s.v[kAccel] = accel[next++].second;
+            s.present = 1u << kAccel;
+        }
+        out.push_back(s);
+    }
+    std::fclose(vib);
+    std::fclose(acc);
+    return !out.empty();
+}
+
+// ---------------------------------------------------------------------------
+// Binary
+
+struct Stream {
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::size_t> frame_start;  // offset of each frame
+    std::vector<std::size_t> frame_first;  // index of its first sample
+};
+
+inline void encode_binary(const std::vector<Sample>& in, Stream& out) {
+    std::uint8_t frame[kFrameBytes];
+    tel::Encoder<kNode> enc(frame, sizeof(frame));
+    out.bytes.clear();
+    out.frame_start.clear();
+    out.frame_first.clear();
+    std::size_t first = 0;
+    auto flush = [&] {
+        const auto f = enc.finish();
+        out.frame_start.push_back(out.bytes.size());
+        out.frame_first.push_back(first);
+        out.bytes.insert(out.bytes.end(), f.begin(), f.end());
+    };
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const Sample& s = in[i];
+        if (!enc.add(s.t, s.v, s.present)) {
+            flush();
+            first = i;
+            enc.add(s.t, s.v, s.present);
+        }
+    }
+    flush();
+}
+
+inline bool same(const tel::Record& r, const Sample& s) {
+    if (r.timestamp != s.t || r.present != (s.present | (0xFu & ~(1u << kAccel)))) return false;
+    for (std::size_t i = 0; i < kNode.kFields; ++i) {
+        if (r.has(i) && r.values[i] != s.v[i]) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// JSON baseline
+
+inline std::size_t encode_json(const std::vector<Sample>& in, std::string& out) {
+    out.clear();
+    char line[128];
+    for (const Sample& s : in) {
+        int n;
+        if (s.present & (1u << kAccel)) {
+            n = std::snprintf(line, sizeof(line), "{\"t\":%u,\"vib\":%d,\"accel_z\":%d,\"clip\":%d,\"seq\":%d}\n",
+                              s.t, s.v[kVib], s.v[kAccel], s.v[kClip], s.v[kSeq]);
+        } else {
+            n = std::snprintf(line, sizeof(line), "{\"t\":%u,\"vib\":%d,\"clip\":%d,\"seq\":%d}\n", s.t,
+                              s.v[kVib], s.v[kClip], s.v[kSeq]);
+        }
+        out.append(line, static_cast<std::size_t>(n));
+    }
+    return out.size();
+}
+
+// Parses one flat object of integer members per line. Returns records read,
+// or 0 on a syntax error.
+template <typename F>
+inline std::size_t decode_json(const std::string& in, F&& on_record) {
+    const char* p = in.c_str();
+    std::size_t records = 0;
+    while (*p != '\0') {
+        tel::Record r;
+        r.schema = nullptr;
+        if (*p++ != '{') return 0;
+        for (;;) {
+            if (*p++ != '"') return 0;
+            const char* key = p;
+            while (*p != '"' && *p != '\0') ++p;
+            const auto klen = static_cast<std::size_t>(p - key);
+            if (*p++ != '"' || *p++ != ':') return 0;
+            char* end;
+            const long v = std::strtol(p, &end, 10);
+            if (end == p) return 0;
+            p = end;
+            if (klen == 1 && key[0] == 't') {
+                r.timestamp = static_cast<std::uint32_t>(v);
+            } else {
+                for (std::size_t i = 0; i < kNode.kFields; ++i) {
+                    const char* name = kNode.fields[i].name;
+                    if (std::strncmp(key, name, klen) == 0 && name[klen] == '\0') {
+                        r.values[i] = static_cast<std::int32_t>(v);
+                        r.present |= 1u << i;
+                        break;
+                    }
+                }
+            }
+            if (*p == ',') {
+                ++p;
+            } else if (*p == '}') {
+                ++p;
+                break;
+            } else {
+                return 0;
+            }
+        }
+        if (*p++ != '\n') return 0;
+        on_record(r);
+        ++records;
+    }
+    return records;
+}
+
+}  // namespace g7::telemetry::test
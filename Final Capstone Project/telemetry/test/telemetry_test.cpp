@@ -0,0 +1,129 @@
+// The binary stream is decoded whole, in random-sized chunks and with one
+// corrupted byte, and the JSON stream is parsed back; every decoded record
+// must match its source.
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "records.hpp"
+
+using namespace g7::telemetry::test;
+
+namespace {
+
+// Decodes `bytes` in chunks drawn from `chunk` and checks every record
+// against `samples` by timestamp. Returns the number of matching records.
+template <typename Chunk>
+std::size_t decode_check(const std::vector<Sample>& samples, const std::vector<std::uint8_t>& bytes, Chunk chunk,
+                         tel::DecoderStats& stats, std::size_t& mismatches) {
+    std::size_t matched = 0;
+    tel::Decoder dec([&](const tel::Record& r) {
+        if (r.timestamp < samples.size() && same(r, samples[r.timestamp])) {
+            ++matched;
+        } else {
+            ++mismatches;
+        }
+    });
+    dec.add_schema(kNode.view());
+    for (std::size_t pos = 0; pos < bytes.size();) {
+        const std::size_t n = std::min(chunk(), bytes.size() - pos);
+        dec.feed(bytes.data() + pos, n);
+        pos += n;
+    }
+    stats = dec.stats();
+    return matched;
+}
+
+int check(const std::vector<Sample>& samples) {
+    const std::size_t n = samples.size();
+    Stream s;
+    encode_binary(samples, s);
+    std::string json;
+    encode_json(samples, json);
+    bool ok = true;
+
+    auto report = [&](bool pass, const char* what, std::size_t got, std::size_t want, std::size_t bad) {
+        std::printf("%s %-25s %zu/%zu records, %zu mismatched\n", pass ? "ok      " : "MISMATCH", what, got, want,
+                    bad);
+        ok = ok && pass;
+    };
+
+    tel::DecoderStats st;
+    std::size_t bad = 0;
+    std::size_t got = decode_check(samples, s.bytes, [&] { return s.bytes.size(); }, st, bad);
+    report(got == n && bad == 0 && st.frames == s.frame_start.size() && st.skipped_bytes == 0, "binary, whole stream",
+           got, n, bad);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> size(1, 97);
+    bad = 0;
+    got = decode_check(samples, s.bytes, [&] { return size(rng); }, st, bad);
+    report(got == n && bad == 0 && st.frames == s.frame_start.size(), "binary, random chunks", got, n, bad);
+
+    // Corrupt one payload byte of a middle frame: only that frame is lost.
+    const std::size_t k = s.frame_start.size() / 2;
+    const std::size_t lost = s.frame_first[k + 1] - s.frame_first[k];
+    std::vector<std::uint8_t> corrupt = s.bytes;
+    corrupt[s.frame_start[k] + tel::kHeaderBytes + 3] ^= 0x10;
+    bad = 0;
+    got = decode_check(samples, corrupt, [&] { return size(rng); }, st, bad);
+    report(got == n - lost && bad == 0 && st.crc_errors >= 1 && st.frames == s.frame_start.size() - 1,
+           "binary, one corrupt byte", got, n - lost, bad);
+
+    // The same frame with a valid CRC over a payload one byte short, or one
+    // byte long: it must be rejected whole, without delivering any record.
+    for (const bool longer : {false, true}) {
+        const std::size_t at = s.frame_start[k];
+        const std::size_t len = s.frame_start[k + 1] - at - tel::kHeaderBytes - tel::kTrailerBytes;
+        std::vector<std::uint8_t> frame(s.bytes.begin() + static_cast<std::ptrdiff_t>(at),
+                                        s.bytes.begin() + static_cast<std::ptrdiff_t>(at + tel::kHeaderBytes + len));
+        if (longer) {
+            frame.push_back(0);
+        } else {
+            frame.pop_back();
+        }
+        const std::size_t bad_len = frame.size() - tel::kHeaderBytes;
+        frame[3] = static_cast<std::uint8_t>(bad_len);
+        frame[4] = static_cast<std::uint8_t>(bad_len >> 8);
+        const std::uint16_t crc = tel::crc16(frame.data() + 1, frame.size() - 1);
+        frame.push_back(static_cast<std::uint8_t>(crc));
+        frame.push_back(static_cast<std::uint8_t>(crc >> 8));
+        std::vector<std::uint8_t> stream(s.bytes.begin(), s.bytes.begin() + static_cast<std::ptrdiff_t>(at));
+        stream.insert(stream.end(), frame.begin(), frame.end());
+        stream.insert(stream.end(), s.bytes.begin() + static_cast<std::ptrdiff_t>(s.frame_start[k + 1]), s.bytes.end());
+        bad = 0;
+        got = decode_check(samples, stream, [&] { return size(rng); }, st, bad);
+        report(got == n - lost && bad == 0 && st.bad_frames == 1 && st.crc_errors == 0 &&
+                   st.frames == s.frame_start.size() - 1,
+               longer ? "binary, trailing byte" : "binary, truncated payload", got, n - lost, bad);
+    }
+
+    bad = 0;
+    got = 0;
+    const std::size_t parsed = decode_json(json, [&](const tel::Record& r) {
+        if (r.timestamp < n && same(r, samples[r.timestamp])) {
+            ++got;
+        } else {
+            ++bad;
+        }
+    });
+    report(parsed == n && got == n && bad == 0, "json", got, n, bad);
+
+    const double rec = static_cast<double>(n);
+    std::printf("%zu records: binary %zu bytes in %zu frames (%.2f bytes/record), json %zu bytes "
+                "(%.2f bytes/record), %.1fx smaller\n",
+                n, s.bytes.size(), s.frame_start.size(), static_cast<double>(s.bytes.size()) / rec, json.size(),
+                static_cast<double>(json.size()) / rec,
+                static_cast<double>(json.size()) / static_cast<double>(s.bytes.size()));
+    return ok ? 0 : 1;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<Sample> samples;
+    if (!load(samples)) return 2;
+    return check(samples);
+}
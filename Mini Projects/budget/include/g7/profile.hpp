@@ -0,0 +1,68 @@
+// Function-level cycle profiler driven by -finstrument-functions.
+//
+// Build the code under test with instrumentation (list the targets in the
+// G7_PROFILE_TARGETS CMake cache variable, or call g7_instrument(target)),
+// then either run it with G7_PROFILE=/tmp/run, which records from static
+// initialisation and writes /tmp/run.folded and /tmp/run.wcet at exit, or
+// drive it by hand:
+//
+//   g7::profile::start();
+//   run_workload();
+//   g7::profile::stop();
+//   g7::profile::write_folded(stdout);    // flamegraph.pl / speedscope input
+//
+// The compiler hooks append {cycles, function} events to a buffer of
+// G7_PROFILE_EVENTS entries owned by the recording thread. When it fills,
+// the thread replays it into the shared per-stack and per-function totals
+// and carries on. The time spent replaying is subtracted from its later
+// timestamps, so it does not show up in the profile. Nothing is dropped.
+//
+// Every thread that calls start() is recorded separately. Results include
+// a thread's calls once it has called stop() or exited; stop the threads
+// before reading them. The .wcet table lists, per function, calls and
+// total, self and worst-case inclusive cycles.
+// Names are resolved with dladdr(), so link instrumented executables with
+// -rdynamic (g7_instrument() does). Local functions come out as
+// "module+0xoffset"; `g7_budget.py symbolize` resolves those with addr2line.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if !defined(G7_PROFILE_EVENTS)
+#define G7_PROFILE_EVENTS (1u << 14)
+#endif
+
+namespace g7::profile {
+
+struct FunctionStats {
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t total = 0;  // inclusive cycles
+    std::uint64_t self = 0;
+    std::uint64_t max = 0;    // worst single call, inclusive
+};
+
+// Starts recording the calling thread. Frames already on the stack are not
+// seen: the profile roots are the functions called after start().
+void start();
+// Stops recording the calling thread and adds its calls to the results.
+// Calls still in progress are counted up to this point.
+void stop();
+bool recording();
+// Clears the results. Threads still recording keep their own state.
+void reset();
+
+// Functions come sorted by worst-case cycles.
+std::vector<FunctionStats> functions();
+// One "root;caller;callee cycles" line per distinct stack, self cycles.
+void write_folded(std::FILE* out);
+// "max_cycles calls total_cycles self_cycles name", a header line first.
+void write_functions(std::FILE* out);
+// Writes <prefix>.folded and <prefix>.wcet. Returns false if either file
+// cannot be created.
+bool dump(const std::string& prefix);
+
+}  // namespace g7::profile
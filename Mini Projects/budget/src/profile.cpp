@@ -0,0 +1,237 @@
+// -finstrument-functions hooks and the replay behind g7::profile.
+// This file must never be built with instrumentation itself.
+
+#include "g7/profile.hpp"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "g7/cycles.hpp"
+
+namespace g7::profile {
+
+namespace {
+
+struct Event {
+    std::uint64_t t;
+    const void* fn;  // nullptr: exit
+};
+
+struct Frame {
+    const void* fn;
+    std::uint64_t enter;
+    std::uint64_t child;
+};
+
+// Owned by the recording thread; only `stack` is replayed under g_mu.
+struct ThreadLog {
+    std::vector<Event> events;
+    std::size_t n = 0;
+    std::uint64_t hidden = 0;  // cycles spent replaying, kept out of the profile
+    bool on = false;
+    std::vector<Frame> stack;
+};
+
+struct Totals {
+    std::uint64_t calls = 0;
+    std::uint64_t total = 0;
+    std::uint64_t self = 0;
+    std::uint64_t max = 0;
+};
+
+// The hooks read the plain pointer; the owner frees the log at thread exit.
+thread_local ThreadLog* t_log = nullptr;
+
+std::mutex g_mu;
+std::vector<const void*> g_key;
+std::map<std::vector<const void*>, std::uint64_t> g_folded;
+std::unordered_map<const void*, Totals> g_totals;
+std::unordered_map<const void*, std::string> g_names;
+
+void close_top(ThreadLog& log, std::uint64_t t) {
+    const Frame f = log.stack.back();
+    const std::uint64_t incl = t > f.enter ? t - f.enter : 0;
+    const std::uint64_t self = incl > f.child ? incl - f.child : 0;
+    Totals& s = g_totals[f.fn];
+    ++s.calls;
+    s.total += incl;
+    s.self += self;
+    s.max = std::max(s.max, incl);
+    g_key.clear();
+    for (const Frame& fr : log.stack) g_key.push_back(fr.fn);
+    g_folded[g_key] += self;
+    log.stack.pop_back();
+    if (!log.stack.empty()) log.stack.back().child += incl;
+}
+
+void replay_locked(ThreadLog& log) {
+    for (std::size_t i = 0; i < log.n; ++i) {
+        const Event& e = log.events[i];
+        if (e.fn != nullptr) {
+            log.stack.push_back({e.fn, e.t, 0});
+        } else if (!log.stack.empty()) {
+            close_top(log, e.t);
+        }
+        // An exit with an empty stack returns from a frame entered before start().
+    }
+    log.n = 0;
+}
+
+void flush(ThreadLog& log) {
+    const std::uint64_t t0 = cycles::now();
+    {
+        std::lock_guard<std::mutex> lock(g_mu);
+        replay_locked(log);
+    }
+    log.hidden += cycles::now() - t0;
+}
+
+inline void record(const void* fn) {
+    ThreadLog* log = t_log;
+    if (log == nullptr || !log->on) return;
+    log->events[log->n++] = {cycles::now() - log->hidden, fn};
+    if (log->n == log->events.size()) flush(*log);
+}
+
+struct LogOwner {
+    std::unique_ptr<ThreadLog> log;
+    ~LogOwner() {
+        if (log && log->on) stop();
+        t_log = nullptr;
+    }
+};
+
+thread_local LogOwner t_owner;
+
+const std::string& name_of(const void* fn) {
+    auto it = g_names.find(fn);
+    if (it != g_names.end()) return it->second;
+    std::string name;
+    Dl_info info{};
+    if (dladdr(fn, &info) != 0 && info.dli_sname != nullptr && info.dli_saddr == fn) {
+        int status = 0;
+        char* d = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        name = status == 0 && d != nullptr ? d : info.dli_sname;
+        std::free(d);
+    } else {
+        char buf[32];
+        const char* module = info.dli_fname != nullptr ? info.dli_fname : "?";
+        if (const char* slash = std::strrchr(module, '/')) module = slash + 1;
+        const auto base = reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+        std::snprintf(buf, sizeof(buf), "+0x%llx",
+                      static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(fn) - base));
+        name = std::string(module) + buf;
+    }
+    // ';' separates frames in the folded format.
+    std::replace(name.begin(), name.end(), ';', ':');
+    return g_names.emplace(fn, std::move(name)).first->second;
+}
+
+std::string g_auto_prefix;
+
+// G7_PROFILE=<prefix>: record the main thread from static initialisation
+// and dump when the program exits.
+struct AutoStart {
+    AutoStart() {
+        const char* prefix = std::getenv("G7_PROFILE");
+        if (prefix == nullptr || *prefix == '\0') return;
+        g_auto_prefix = prefix;
+        std::atexit([] {
+            stop();
+            if (!dump(g_auto_prefix)) std::fprintf(stderr, "g7::profile: cannot write %s.*\n", g_auto_prefix.c_str());
+        });
+        start();
+    }
+} g_auto_start;
+
+}  // namespace
+
+void start() {
+    if (!t_owner.log) {
+        t_owner.log = std::make_unique<ThreadLog>();
+        t_owner.log->events.resize(G7_PROFILE_EVENTS);
+        t_log = t_owner.log.get();
+    }
+    t_log->on = true;
+}
+
+void stop() {
+    ThreadLog* log = t_log;
+    if (log == nullptr || !log->on) return;
+    log->on = false;
+    const std::uint64_t t = cycles::now() - log->hidden;
+    std::lock_guard<std::mutex> lock(g_mu);
+    replay_locked(*log);
+    while (!log->stack.empty()) close_top(*log, t);
+}
+
+bool recording() { return t_log != nullptr && t_log->on; }
+
+void reset() {
+    std::lock_guard<std::mutex> lock(g_mu);
+    g_folded.clear();
+    g_totals.clear();
+}
+
+std::vector<FunctionStats> functions() {
+    std::lock_guard<std::mutex> lock(g_mu);
+    std::vector<FunctionStats> out;
+    out.reserve(g_totals.size());
+    for (const auto& [fn, s] : g_totals) out.push_back({name_of(fn), s.calls, s.total, s.self, s.max});
+    std::sort(out.begin(), out.end(), [](const FunctionStats& a, const FunctionStats& b) { return a.max > b.max; });
+    return out;
+}
+
+void write_folded(std::FILE* out) {
+    std::lock_guard<std::mutex> lock(g_mu);
+    for (const auto& [stack, cycles] : g_folded) {
+        if (cycles == 0) continue;
+        for (std::size_t i = 0; i < stack.size(); ++i) {
+            std::fprintf(out, "%s%s", i ? ";" : "", name_of(stack[i]).c_str());
+        }
+        std::fprintf(out, " %llu\n", static_cast<unsigned long long>(cycles));
+    }
+}
+
+void write_functions(std::FILE* out) {
+    const std::vector<FunctionStats> fns = functions();
+    std::fprintf(out, "# max_cycles calls total_cycles self_cycles function\n");
+    for (const FunctionStats& f : fns) {
+        std::fprintf(out, "%llu %llu %llu %llu %s\n", static_cast<unsigned long long>(f.max),
+                     static_cast<unsigned long long>(f.calls), static_cast<unsigned long long>(f.total),
+                     static_cast<unsigned long long>(f.self), f.name.c_str());
+    }
+}
+
+bool dump(const std::string& prefix) {
+    std::FILE* folded = std::fopen((prefix + ".folded").c_str(), "w");
+    std::FILE* wcet = std::fopen((prefix + ".wcet").c_str(), "w");
+    if (folded != nullptr) write_folded(folded);
+    if (wcet != nullptr) write_functions(wcet);
+    const bool ok = folded != nullptr && wcet != nullptr;
+    if (folded != nullptr) std::fclose(folded);
+    if (wcet != nullptr) std::fclose(wcet);
+    return ok;
+}
+
+}  // namespace g7::profile
+
+extern "C" {
+
+__attribute__((no_instrument_function)) void __cyg_profile_func_enter(void* fn, void* /*call_site*/) {
+    g7::profile::record(fn);
+}
+
+__attribute__((no_instrument_function)) void __cyg_profile_func_exit(void* /*fn*/, void* /*call_site*/) {
+    g7::profile::record(nullptr);
+}
+
+}  // extern "C"
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Budget tool checks.
+
+    budget_test.py --tool tools/g7_budget.py --toy build/.../g7_profile_toy
+
+profile: runs the instrumented toy with G7_PROFILE set and checks the call
+stacks and counts in the .folded and .wcet files it writes, that the two
+agree on cycles, and that `g7_budget.py wcet` fails a function over budget.
+
+report: writes a link map with .ci and .su files for a two-target image,
+runs `g7_budget.py report` on it, and checks the RAM, flash and stack
+totals, the per-target split, that .ci wins over .su, and the exit status
+within and over budget.
+"""
+
+import argparse
+import collections
+import json
+import os
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+ok = True
+
+
+def report(passed, what, detail=""):
+    global ok
+    print("%s %-34s %s" % ("ok      " if passed else "MISMATCH", what, detail))
+    ok = ok and passed
+
+
+def run(cmd, **kwargs):
+    return subprocess.run(cmd, capture_output=True, text=True, check=False, **kwargs)
+
+
+# ---------------------------------------------------------------------------
+# Profiler
+
+def short(name):
+    """'toy_leaf(unsigned int)' -> 'toy_leaf'."""
+    return name.split("(")[0]
+
+
+def profile(args, tmp):
+    prefix = str(tmp / "toy")
+    env = dict(os.environ, G7_PROFILE=prefix)
+    r = run([args.toy], env=env)
+    if r.returncode != 0:
+        report(False, "profile: toy run", "exit %d: %s" % (r.returncode, r.stderr.strip()))
+        return
+
+    folded = collections.Counter()
+    with open(prefix + ".folded", encoding="utf-8") as f:
+        for line in f:
+            stack, cycles = line.rsplit(" ", 1)
+            folded[";".join(short(s) for s in stack.split(";"))] += int(cycles)
+    want = {"main", "main;toy_middle", "main;toy_middle;toy_leaf", "main;toy_leaf"}
+    report(set(folded) == want, "profile: folded stacks", ", ".join(sorted(folded)))
+
+    wcet = {}
+    with open(prefix + ".wcet", encoding="utf-8") as f:
+        for line in f:
+            if line.startswith("#"):
+                continue
+            worst, calls, total, own, name = line.rstrip("\n").split(" ", 4)
+            wcet[short(name)] = (int(worst), int(calls), int(total), int(own))
+    calls = {name: row[1] for name, row in wcet.items()}
+    report(calls == {"main": 1, "toy_middle": 2, "toy_leaf": 7}, "profile: wcet call counts",
+           ", ".join("%s %d" % kv for kv in sorted(calls.items())))
+
+    # Self cycles in .wcet are the folded lines ending in that function;
+    # main's inclusive total is every folded line.
+    self_from_folded = collections.Counter()
+    for stack, cycles in folded.items():
+        self_from_folded[stack.split(";")[-1]] += cycles
+    consistent = all(self_from_folded[name] == row[3] and row[3] <= row[2] and row[0] <= row[2]
+                     for name, row in wcet.items())
+    consistent = consistent and "main" in wcet and wcet["main"][2] == sum(folded.values())
+    report(consistent, "profile: folded and wcet agree", "%d cycles" % sum(folded.values()))
+
+    budgets = tmp / "wcet.json"
+    budgets.write_text(json.dumps({"wcet": {"toy_leaf": 1}}))
+    r = run([sys.executable, args.tool, "wcet", prefix + ".wcet", "--budgets", str(budgets)])
+    report(r.returncode == 1 and "toy_leaf" in r.stdout, "profile: wcet over budget", "exit %d" % r.returncode)
+
+
+# ---------------------------------------------------------------------------
+# Static report
+
+# app links main.cpp.o and extra.cpp.o itself and toy.cpp.o from libtoy.a.
+MAP = """\
+Memory Configuration
+
+Linker script and memory map
+
+ .text.main     0x0000000000001000       0x40 CMakeFiles/app.dir/main.cpp.o
+ .text._Z5firstv
+                0x0000000000001040      0x200 CMakeFiles/app.dir/main.cpp.o
+ .text._Z5sparev
+                0x0000000000001240       0x20 CMakeFiles/app.dir/extra.cpp.o
+ .text._Z6helperv
+                0x0000000000001260      0x100 libtoy.a(toy.cpp.o)
+ .text._Z3isrv  0x0000000000001360       0x40 libtoy.a(toy.cpp.o)
+ .rodata._ZL5table
+                0x0000000000002000      0x400 libtoy.a(toy.cpp.o)
+ .data._ZL5state
+                0x0000000000003000       0x10 CMakeFiles/app.dir/main.cpp.o
+ .bss._ZL6buffer
+                0x0000000000004000      0x800 libtoy.a(toy.cpp.o)
+ .bss           0x0000000000004800        0x8 /usr/lib/gcc/x86_64-linux-gnu/12/crtbeginS.o
+ .comment       0x0000000000000000       0x1f /usr/lib/gcc/x86_64-linux-gnu/12/crtbeginS.o
+"""
+TEXT = 0x40 + 0x200 + 0x20 + 0x100 + 0x40
+RODATA = 0x400
+DATA = 0x10
+BSS = 0x800 + 0x8
+RAM = DATA + BSS
+FLASH = TEXT + RODATA + DATA
+
+# main (48) -> first (256) -> helper (512), plus a call to puts, which has no
+# stack data. isr (96) -> helper is a root of its own.
+MAIN_CI = r"""graph: { title: "main.cpp"
+node: { title: "main" label: "int main()\nmain.cpp:9:5\n48 bytes (static)" }
+node: { title: "_Z5firstv" label: "void first()\nmain.cpp:4:6\n256 bytes (static)" }
+node: { title: "_Z6helperv" label: "void helper()\ntoy.hpp:3:6" shape : ellipse }
+node: { title: "puts" label: "puts\n<built-in>" shape : ellipse }
+edge: { sourcename: "main" targetname: "_Z5firstv" label: "main.cpp:10:10" }
+edge: { sourcename: "main" targetname: "puts" label: "main.cpp:11:9" }
+edge: { sourcename: "_Z5firstv" targetname: "_Z6helperv" label: "main.cpp:5:11" }
+}
+"""
+TOY_CI = r"""graph: { title: "toy.cpp"
+node: { title: "_Z6helperv" label: "void helper()\ntoy.cpp:3:6\n512 bytes (static)" }
+node: { title: "_Z3isrv" label: "void isr()\ntoy.cpp:8:6\n96 bytes (static)" }
+edge: { sourcename: "_Z3isrv" targetname: "_Z6helperv" label: "toy.cpp:9:11" }
+}
+"""
+STACK = 48 + 256 + 512
+
+
+def write_build(root):
+    (root / "app.map").write_text(MAP)
+    app = root / "CMakeFiles" / "app.dir"
+    toy = root / "CMakeFiles" / "toy.dir"
+    app.mkdir(parents=True)
+    toy.mkdir(parents=True)
+    for obj in (app / "main.cpp.o", app / "extra.cpp.o", toy / "toy.cpp.o"):
+        obj.write_bytes(b"")
+    (app / "main.cpp.ci").write_text(MAIN_CI)
+    (toy / "toy.cpp.ci").write_text(TOY_CI)
+    # GCC writes both; the report must prefer the call graph. A .su alone
+    # gives frame sizes without edges.
+    (app / "main.cpp.su").write_text("main.cpp:9:5:int main()\t9999\tstatic\n")
+    (app / "extra.cpp.su").write_text("extra.cpp:2:6:void spare()\t2000\tstatic\n")
+
+
+def static_report(args, tmp):
+    root = tmp / "build"
+    root.mkdir()
+    write_build(root)
+
+    def check(budget):
+        path = tmp / "budgets.json"
+        path.write_text(json.dumps({"app": budget}))
+        return run([sys.executable, args.tool, "report", str(root), "--budgets", str(path)])
+
+    exact = check({"ram": RAM, "flash": FLASH, "stack": STACK})
+    out = exact.stdout
+    report(exact.returncode == 0 and "BUDGET EXCEEDED" not in out, "report: at budget passes",
+           "exit %d" % exact.returncode)
+    report("by target: toy 2.0 KiB, app 16 B, toolchain 8 B" in out, "report: RAM by target",
+           next((l.strip() for l in out.splitlines() if "by target" in l), "-"))
+    lines = [l.strip() for l in out.splitlines()]
+    paths = ["816 B  main [external]", "main -> first -> helper", "608 B  isr", "isr -> helper",
+             "2.0 KiB  void spare()"]
+    report(all(p in lines for p in paths) and "9999" not in out, "report: stack paths, .ci over .su",
+           "main %d B, isr 608 B, spare 2000 B" % STACK)
+
+    over = check({"ram": RAM - 1, "flash": FLASH - 1, "stack": STACK - 1})
+    want = ["app: ram %d B exceeds budget %d B" % (RAM, RAM - 1),
+            "app: flash %d B exceeds budget %d B" % (FLASH, FLASH - 1),
+            "app: stack %d B exceeds budget %d B" % (STACK, STACK - 1)]
+    found = [w for w in want if "BUDGET EXCEEDED  " + w in over.stdout]
+    report(over.returncode == 1 and found == want, "report: totals, one byte over",
+           "exit %d, ram %d B, flash %d B, stack %d B" % (over.returncode, RAM, FLASH, STACK))
+
+    missing = run([sys.executable, args.tool, "report", str(tmp / "nothing")])
+    report(missing.returncode == 2, "report: no link maps", "exit %d" % missing.returncode)
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("--tool", required=True, help="g7_budget.py")
+    p.add_argument("--toy", required=True, help="instrumented g7_profile_toy executable")
+    args = p.parse_args()
+    with tempfile.TemporaryDirectory(prefix="g7_budget_") as tmp:
+        profile(args, Path(tmp))
+        static_report(args, Path(tmp))
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
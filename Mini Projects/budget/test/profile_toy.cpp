@@ -0,0 +1,23 @@
+// Instrumented workload for budget_test.py: a fixed call tree whose call
+// counts and stacks the test checks in the .folded and .wcet files that a
+// G7_PROFILE run writes.
+//
+//   main -> toy_middle (x2) -> toy_leaf (x3 each)
+//   main -> toy_leaf (x1)
+
+volatile unsigned g_sink;
+
+__attribute__((noinline)) void toy_leaf(unsigned n) {
+    for (unsigned i = 0; i < n; ++i) g_sink = g_sink + i;
+}
+
+__attribute__((noinline)) void toy_middle() {
+    for (int i = 0; i < 3; ++i) toy_leaf(1000);
+}
+
+int main() {
+    toy_middle();
+    toy_middle();
+    toy_leaf(10);
+    return 0;
+}
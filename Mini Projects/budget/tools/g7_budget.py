@@ -0,0 +1,517 @@
+#!/usr/bin/env python3
+"""RAM, flash, stack and timing budgets for a G7_ES build tree.
+
+    g7_budget.py report BUILD_DIR [--budgets FILE] [--target NAME ...] [--top N]
+    g7_budget.py wcet PROFILE.wcet [--budgets FILE] [--exe BINARY] [--hz HZ] [--top N]
+    g7_budget.py symbolize PROFILE.folded --exe BINARY > resolved.folded
+
+`report` reads what a -DG7_BUDGET=ON build leaves behind:
+    <image>.map   link map of every executable (-Wl,-Map)
+    *.ci          per-object call graph with frame sizes (GCC -fcallgraph-info=su)
+    *.su          per-function frame sizes (-fstack-usage), used when there is no .ci
+
+For each executable it prints:
+    - static RAM (.data + .bss), split by the CMake target that owns it;
+    - flash (.text + .rodata + .data initialisers) and the top consumers,
+      per symbol thanks to -ffunction-sections;
+    - the worst-case stack from main() and from the heaviest functions no
+      one calls directly (ISRs, thread entries, callbacks), with the path.
+
+A stack figure is a lower bound when the path is flagged:
+    recursion  a cycle in the call graph (each cycle counted once)
+    indirect   a call through a pointer or a virtual call
+    dynamic    a frame with alloca or a VLA
+    external   a call into code without stack data (libc, libstdc++)
+
+`wcet` prints a g7::profile .wcet table sorted by worst-case cycles, with
+names resolved through --exe. `symbolize` rewrites "module+0xOFFSET"
+frames in a folded profile to function names with addr2line.
+
+The budgets file is JSON, keyed by executable name:
+    {"g7_sim_sensor_node": {"ram": 8192, "flash": 262144, "stack": 4096},
+     "wcet": {"g7::dsp::fir": 60000}}
+wcet keys are name prefixes, limits are cycles. Exit status: 0 within budget,
+1 over budget, 2 bad input.
+"""
+
+import argparse
+import collections
+import json
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+# ---------------------------------------------------------------------------
+# Link maps
+
+INPUT_SECTION = re.compile(r"^ (\.\S+|COMMON)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+))?$")
+CONTINUATION = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+)$")
+SYMBOL_SECTION = re.compile(
+    r"^\.(?:text|rodata|data|bss|tdata|tbss)(?:\.rel\.ro)?(?:\.local)?"
+    r"(?:\.(?:unlikely|startup|hot|exit))?\.(.+)$")
+
+
+def classify(section):
+    """Returns 'text', 'rodata', 'data', 'bss' or None."""
+    if section == "COMMON" or section.startswith((".bss", ".tbss")):
+        return "bss"
+    if section.startswith((".text", ".init", ".fini")):
+        return "text"
+    # Read-only after relocation: flash on the target.
+    if section.startswith((".rodata", ".data.rel.ro", ".eh_frame", ".gcc_except_table")):
+        return "rodata"
+    if section.startswith((".data", ".tdata")):
+        return "data"
+    return None
+
+
+def owner_of(path):
+    """CMake target that produced an input file, or 'toolchain'."""
+    if path.startswith("/usr/") or "/gcc/" in path:
+        return "toolchain"
+    m = re.search(r"CMakeFiles/([^/]+)\.dir/", path)
+    if m:
+        return m.group(1)
+    m = re.search(r"(?:^|/)lib([^/()]+)\.a\(", path)
+    if m:
+        return m.group(1)
+    return "toolchain"
+
+
+def parse_map(path):
+    """Yields (section, size, input file) for every kept input section."""
+    in_memory_map = False
+    pending = None
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if not in_memory_map:
+                in_memory_map = line.startswith("Linker script and memory map")
+                continue
+            if pending is not None:
+                m = CONTINUATION.match(line)
+                if m:
+                    yield pending, int(m.group(2), 16), m.group(3).strip()
+                pending = None
+                continue
+            m = INPUT_SECTION.match(line)
+            if not m:
+                continue
+            if m.group(2) is None:
+                pending = m.group(1)
+            else:
+                yield m.group(1), int(m.group(3), 16), m.group(4).strip()
+
+
+def demangle(names):
+    """Mangled -> readable name, without parameter lists, cut to one line."""
+    names = list(names)
+    tool = shutil.which("c++filt")
+    lines = []
+    if tool and names:
+        out = subprocess.run([tool, "-p"], input="\n".join(names), capture_output=True, text=True, check=False)
+        lines = out.stdout.splitlines()
+    if len(lines) != len(names):
+        lines = names
+    return {n: d if len(d) <= 100 else d[:97] + "..." for n, d in zip(names, lines)}
+
+
+class Image:
+    def __init__(self, map_path):
+        self.map_path = map_path
+        self.name = map_path.name[:-len(".map")]
+        self.sizes = collections.Counter()  # kind -> bytes
+        self.ram_by_owner = collections.Counter()
+        self.flash_by_symbol = collections.Counter()  # (owner, symbol) -> bytes
+        self.inputs = set()
+        for section, size, path in parse_map(map_path):
+            kind = classify(section)
+            self.inputs.add(path)
+            if kind is None or size == 0:
+                continue
+            self.sizes[kind] += size
+            owner = owner_of(path)
+            if kind in ("data", "bss"):
+                self.ram_by_owner[owner] += size
+            if kind != "bss":
+                m = SYMBOL_SECTION.match(section)
+                if m and m.group(1) not in ("unlikely", "startup", "hot", "exit"):
+                    symbol = m.group(1)
+                else:
+                    symbol = "%s %s" % (os.path.basename(path), section)
+                self.flash_by_symbol[(owner, symbol)] += size
+
+    @property
+    def ram(self):
+        return self.sizes["data"] + self.sizes["bss"]
+
+    @property
+    def flash(self):
+        return self.sizes["text"] + self.sizes["rodata"] + self.sizes["data"]
+
+    def object_files(self, build_dir):
+        """Object files linked into the image, as paths in the build tree."""
+        base = self.map_path.parent
+        objects = []
+        for path in self.inputs:
+            m = re.match(r"^(.*)\((.+\.o)\)$", path)
+            if m:  # archive member: find it in the archive's CMakeFiles/<target>.dir
+                archive = Path(m.group(1))
+                archive = archive if archive.is_absolute() else base / archive
+                target = re.sub(r"^lib|\.a$", "", archive.name)
+                objects.extend((archive.parent / "CMakeFiles" / (target + ".dir")).rglob(m.group(2)))
+            elif path.endswith(".o") and "CMakeFiles/" in path:
+                for root in (base, build_dir):
+                    if (root / path).exists():
+                        objects.append(root / path)
+                        break
+        return objects
+
+
+# ---------------------------------------------------------------------------
+# Call graphs
+
+CI_NODE = re.compile(r'^node: \{ title: "((?:[^"\\]|\\.)*)" label: "((?:[^"\\]|\\.)*)"(.*)\}\s*$')
+CI_EDGE = re.compile(r'^edge: \{ sourcename: "((?:[^"\\]|\\.)*)" targetname: "((?:[^"\\]|\\.)*)"')
+CI_STACK = re.compile(r"(\d+) bytes \(([a-z,]+)\)")
+SU_LINE = re.compile(r"^(.*?):\d+:\d+:(.*)\t(\d+)\t([a-z,]+)$")
+LOCAL_TITLE = re.compile(r"^.+\.(?:c|cc|cpp|cxx|h|hh|hpp|tcc):(.+)$")  # file-local: "path:symbol"
+
+
+class Function:
+    __slots__ = ("key", "name", "frame", "qualifier", "callees")
+
+    def __init__(self, key, name, frame, qualifier):
+        self.key = key
+        self.name = name
+        self.frame = frame
+        self.qualifier = qualifier
+        self.callees = []
+
+
+class CallGraph:
+    def __init__(self, objects):
+        self.functions = {}  # (object, title) -> Function
+        self.by_title = collections.defaultdict(list)
+        self.has_edges = False
+        raw_edges = []
+        for obj in objects:
+            ci = obj.with_suffix(".ci")
+            su = obj.with_suffix(".su")
+            if ci.exists():
+                self.has_edges = True
+                self._read_ci(ci, raw_edges)
+            elif su.exists():
+                self._read_su(su)
+        callers = collections.Counter()
+        for obj, src, dst in raw_edges:
+            f = self.functions.get((obj, src))
+            if f is None:
+                continue
+            target = self._resolve(obj, dst)
+            f.callees.append(target if target is not None else dst)
+            if target is not None:
+                callers[target.key] += 1
+        self.uncalled = [f for f in self.functions.values() if callers[f.key] == 0]
+        symbols = {f.key[1]: self._symbol(f.key[1]) for f in self.functions.values()}
+        names = demangle(set(symbols.values()))
+        for f in self.functions.values():
+            f.name = names[symbols[f.key[1]]]
+
+    @staticmethod
+    def _symbol(title):
+        m = LOCAL_TITLE.match(title)
+        return m.group(1) if m else title
+
+    def _read_ci(self, path, raw_edges):
+        obj = str(path)
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = CI_NODE.match(line)
+                if m:
+                    s = CI_STACK.search(m.group(2))
+                    if s is None:  # declaration only: external
+                        continue
+                    self._add(Function((obj, m.group(1)), m.group(1), int(s.group(1)), s.group(2)))
+                    continue
+                m = CI_EDGE.match(line)
+                if m:
+                    raw_edges.append((obj, m.group(1), m.group(2)))
+
+    def _read_su(self, path):
+        obj = str(path)
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = SU_LINE.match(line.rstrip("\n"))
+                if m:
+                    self._add(Function((obj, m.group(2)), m.group(2), int(m.group(3)), m.group(4)))
+
+    def _add(self, fn):
+        self.functions[fn.key] = fn
+        self.by_title[fn.key[1]].append(fn)
+
+    def _resolve(self, obj, title):
+        # GCC emits the base-object constructor/destructor (C2/D2) and makes
+        # the complete-object one (C1/D1) an alias, so callers name the alias.
+        for t in (title, re.sub(r"([CD])1E", r"\g<1>2E", title)):
+            f = self.functions.get((obj, t))
+            if f is not None:
+                return f
+            defs = self.by_title.get(t)
+            if defs:
+                return defs[0]
+        return None
+
+    def find(self, title):
+        defs = self.by_title.get(title)
+        return defs[0] if defs else None
+
+    def worst(self, root):
+        """(bytes, flags, path) of the deepest stack below `root`."""
+        memo = {}
+        visiting = set()
+        sys.setrecursionlimit(max(10000, sys.getrecursionlimit()))
+
+        def visit(f):
+            if f.key in memo:
+                return memo[f.key]
+            if f.key in visiting:
+                return 0, {"recursion"}, []
+            visiting.add(f.key)
+            flags = set()
+            if f.qualifier.startswith("dynamic") and "bounded" not in f.qualifier:
+                flags.add("dynamic")
+            best, best_path = 0, []
+            for c in f.callees:
+                if isinstance(c, str):
+                    flags.add("indirect" if c == "__indirect_call" else "external")
+                    continue
+                depth, sub_flags, path = visit(c)
+                flags |= sub_flags
+                if depth > best:
+                    best, best_path = depth, path
+            visiting.discard(f.key)
+            result = (f.frame + best, flags, [f] + best_path)
+            memo[f.key] = result
+            return result
+
+        return visit(root)
+
+
+# ---------------------------------------------------------------------------
+# Report
+
+def kib(n):
+    return "%.1f KiB" % (n / 1024.0) if n >= 1024 else "%d B" % n
+
+
+def load_budgets(path):
+    if not path:
+        return {}
+    try:
+        with open(path, encoding="utf-8") as f:
+            return json.load(f)
+    except (OSError, ValueError) as e:
+        sys.exit("g7_budget: cannot read budgets %s: %s" % (path, e))
+
+
+def check(failures, image, what, value, budget):
+    limit = budget.get(what)
+    if limit is None:
+        return ""
+    if value > limit:
+        failures.append("%s: %s %d B exceeds budget %d B" % (image, what, value, limit))
+        return "  OVER BUDGET (%s)" % kib(limit)
+    return "  (budget %s, %d%%)" % (kib(limit), 100 * value // max(limit, 1))
+
+
+def stack_line(fn, graph, limit_path=6):
+    depth, flags, path = graph.worst(fn)
+    names = [p.name if len(p.name) <= 60 else p.name[:57] + "..." for p in path]
+    if len(names) > limit_path:
+        names = names[:limit_path - 1] + ["... (%d more)" % (len(names) - limit_path + 1)]
+    note = " [%s]" % ", ".join(sorted(flags)) if flags else ""
+    return depth, "%8s  %s%s\n            %s" % (kib(depth), fn.name, note, " -> ".join(names))
+
+
+def report(args):
+    build = Path(args.build_dir).resolve()
+    maps = sorted(build.rglob("*.map"))
+    if args.target:
+        maps = [m for m in maps if m.name[:-len(".map")] in args.target]
+    if not maps:
+        sys.stderr.write("g7_budget: no link maps under %s; configure with -DG7_BUDGET=ON and build\n" % build)
+        return 2
+    budgets = load_budgets(args.budgets)
+    failures = []
+
+    for map_path in maps:
+        image = Image(map_path)
+        budget = budgets.get(image.name, {})
+        print("== %s" % image.name)
+
+        print("static RAM  %9s  (.data %s, .bss %s)%s" % (
+            kib(image.ram), kib(image.sizes["data"]), kib(image.sizes["bss"]),
+            check(failures, image.name, "ram", image.ram, budget)))
+        owners = ", ".join("%s %s" % (o, kib(n)) for o, n in image.ram_by_owner.most_common())
+        print("            by target: %s" % (owners or "-"))
+
+        print("flash       %9s  (.text %s, .rodata %s, .data %s)%s" % (
+            kib(image.flash), kib(image.sizes["text"]), kib(image.sizes["rodata"]), kib(image.sizes["data"]),
+            check(failures, image.name, "flash", image.flash, budget)))
+        top = image.flash_by_symbol.most_common(args.top)
+        names = demangle(sym for (_, sym), _ in top)
+        for (owner, sym), size in top:
+            print("  %9s  %-22s %s" % (kib(size), owner, names.get(sym, sym)))
+
+        graph = CallGraph(image.object_files(build))
+        if not graph.functions:
+            print("stack       no .su/.ci data found for this image\n")
+            continue
+        if not graph.has_edges:
+            print("stack       frame sizes only (no call graph; build with GCC for -fcallgraph-info)")
+            for f in sorted(graph.functions.values(), key=lambda f: -f.frame)[:args.top]:
+                print("  %9s  %s" % (kib(f.frame), f.name))
+            print()
+            continue
+
+        main = graph.find("main")
+        if main is not None:
+            depth, line = stack_line(main, graph)
+            print("stack       worst case from main()%s" % check(failures, image.name, "stack", depth, budget))
+            print("  " + line)
+        roots = [f for f in graph.uncalled if f is not main]
+        ranked = sorted(((graph.worst(f)[0], f) for f in roots), key=lambda x: -x[0])[:args.top]
+        if ranked:
+            print("            heaviest functions with no direct caller:")
+            for _, f in ranked:
+                print("  " + stack_line(f, graph)[1])
+        print()
+
+    for line in failures:
+        print("BUDGET EXCEEDED  " + line)
+    return 1 if failures else 0
+
+
+# ---------------------------------------------------------------------------
+# Profiles
+
+def elf_load_base(exe):
+    """Link-time address that dladdr() offsets are relative to."""
+    with open(exe, "rb") as f:
+        ident = f.read(16)
+        if ident[:4] != b"\x7fELF" or ident[4] != 2:
+            return 0
+        e_type, = struct.unpack("<H", f.read(2))
+        if e_type != 2:  # ET_DYN (PIE): offsets are already link-time addresses
+            return 0
+        f.seek(0x20)
+        e_phoff, = struct.unpack("<Q", f.read(8))
+        f.seek(0x36)
+        e_phentsize, e_phnum = struct.unpack("<HH", f.read(4))
+        base = None
+        for i in range(e_phnum):
+            f.seek(e_phoff + i * e_phentsize)
+            p_type, _, _, p_vaddr = struct.unpack("<IIQQ", f.read(24))
+            if p_type == 1 and (base is None or p_vaddr < base):
+                base = p_vaddr
+        return base or 0
+
+
+def resolver(exe):
+    """Maps "module+0xOFF" to a function name via addr2line."""
+    module = os.path.basename(exe)
+    base = elf_load_base(exe)
+    pattern = re.compile(r"^%s\+0x([0-9a-f]+)$" % re.escape(module))
+    cache = {}
+
+    def resolve_all(frames):
+        todo = sorted({f for f in frames if pattern.match(f) and f not in cache})
+        if todo and shutil.which("addr2line"):
+            addrs = ["0x%x" % (int(pattern.match(f).group(1), 16) + base) for f in todo]
+            out = subprocess.run(["addr2line", "-f", "-C", "-e", exe] + addrs,
+                                 capture_output=True, text=True, check=False).stdout.splitlines()
+            for i, frame in enumerate(todo):
+                name = out[2 * i] if 2 * i < len(out) else "??"
+                cache[frame] = frame if name == "??" else name.replace(";", ":")
+        return {f: cache.get(f, f) for f in frames}
+
+    return resolve_all
+
+
+def symbolize(args):
+    resolve = resolver(args.exe)
+    lines = Path(args.profile).read_text(encoding="utf-8").splitlines()
+    parsed = [line.rsplit(" ", 1) for line in lines if line.strip()]
+    names = resolve({frame for stack, _ in parsed for frame in stack.split(";")})
+    folded = collections.Counter()
+    for stack, count in parsed:
+        folded[";".join(names[f] for f in stack.split(";"))] += int(count)
+    for stack, count in folded.items():
+        print("%s %d" % (stack, count))
+    return 0
+
+
+def wcet(args):
+    rows = []
+    with open(args.profile, encoding="utf-8") as f:
+        for line in f:
+            if line.startswith("#") or not line.strip():
+                continue
+            mx, calls, total, self_, name = line.rstrip("\n").split(" ", 4)
+            rows.append([int(mx), int(calls), int(total), int(self_), name])
+    if args.exe:
+        names = resolver(args.exe)({r[4] for r in rows})
+        for r in rows:
+            r[4] = names[r[4]]
+    rows.sort(key=lambda r: -r[0])
+    budgets = load_budgets(args.budgets).get("wcet", {})
+    failures = []
+
+    unit = "us" if args.hz else "cycles"
+    scale = 1e6 / args.hz if args.hz else 1.0
+    print("%12s %10s %12s %12s  function" % ("max " + unit, "calls", "mean " + unit, "self %"))
+    grand = sum(r[3] for r in rows) or 1
+    for mx, calls, total, self_, name in rows[:args.top]:
+        print("%12.1f %10d %12.1f %11.1f%%  %s" % (mx * scale, calls, total * scale / max(calls, 1),
+                                                   100.0 * self_ / grand, name))
+    for prefix, limit in budgets.items():
+        for mx, _, _, _, name in rows:
+            if name.startswith(prefix) and mx > limit:
+                failures.append("%s: %d cycles exceeds budget %d" % (name, mx, limit))
+    for line in failures:
+        print("BUDGET EXCEEDED  " + line)
+    return 1 if failures else 0
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n\n", 1)[0])
+    sub = p.add_subparsers(dest="command", required=True)
+
+    r = sub.add_parser("report", help="RAM, flash and stack per executable")
+    r.add_argument("build_dir")
+    r.add_argument("--budgets")
+    r.add_argument("--target", action="append", help="only this executable (repeatable)")
+    r.add_argument("--top", type=int, default=10)
+
+    w = sub.add_parser("wcet", help="worst-case cycles per function from a g7::profile .wcet file")
+    w.add_argument("profile")
+    w.add_argument("--budgets")
+    w.add_argument("--exe")
+    w.add_argument("--hz", type=float, help="cycle counter frequency, to print microseconds")
+    w.add_argument("--top", type=int, default=20)
+
+    s = sub.add_parser("symbolize", help="resolve module+0xOFFSET frames in a folded profile")
+    s.add_argument("profile")
+    s.add_argument("--exe", required=True)
+
+    args = p.parse_args()
+    return {"report": report, "wcet": wcet, "symbolize": symbolize}[args.command](args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
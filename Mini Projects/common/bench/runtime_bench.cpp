@@ -0,0 +1,175 @@
+// Microbenchmarks for the shared runtime: ring buffer push/pop latency,
+// producer/consumer burst throughput and pool allocator throughput.
+//
+//   ./g7_runtime_bench --benchmark_counters_tabular=true
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "g7/block_pool.hpp"
+#include "g7/cycles.hpp"
+#include "g7/spsc_ring.hpp"
+
+namespace {
+
+struct Sample {
+    std::uint32_t timestamp;
+    std::int16_t channel[4];
+};
+
+void set_cycles_per_op(benchmark::State& state, std::uint64_t cycles, std::int64_t ops) {
+    state.counters["cycles/op"] =
+        benchmark::Counter(static_cast<double>(cycles) / static_cast<double>(ops ? ops : 1));
+}
+
+void BM_SpscPushPop(benchmark::State& state) {
+    static g7::SpscRing<Sample, 1024> ring;
+    Sample in{1, {1, 2, 3, 4}};
+    Sample out{};
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        ring.push(in);
+        ring.pop(out);
+        benchmark::DoNotOptimize(out);
+        ++in.timestamp;
+    }
+    set_cycles_per_op(state, g7::cycles::now() - c0, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscPushPop);
+
+// Fill the ring with a burst of `range(0)` samples, then drain it, as an ISR
+// would during a DMA half-transfer followed by one task wake-up.
+void BM_SpscBurst(benchmark::State& state) {
+    static g7::SpscRing<Sample, 4096> ring;
+    const auto burst = static_cast<std::size_t>(state.range(0));
+    Sample s{0, {}};
+    Sample out{};
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < burst; ++i) {
+            s.timestamp = static_cast<std::uint32_t>(i);
+            ring.push(s);
+        }
+        while (ring.pop(out)) {
+            benchmark::DoNotOptimize(out);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpscBurst)->Arg(16)->Arg(256)->Arg(4096);
+
+void BM_SpscBulkBurst(benchmark::State& state) {
+    static g7::SpscRing<Sample, 4096> ring;
+    static Sample block[4096];
+    const auto burst = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        ring.push(block, burst);
+        benchmark::DoNotOptimize(ring.pop(block, burst));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpscBulkBurst)->Arg(16)->Arg(256)->Arg(4096);
+
+// Producer thread streams samples while the timed thread consumes. Reports
+// the fraction of pushes rejected because the ring was full.
+void BM_SpscProducerConsumer(benchmark::State& state) {
+    static g7::SpscRing<Sample, 1024> ring;
+    std::atomic<bool> stop{false};
+    std::uint64_t dropped = 0;
+    std::uint64_t pushed = 0;
+    std::thread producer([&] {
+        Sample s{0, {}};
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (ring.push(s)) {
+                ++s.timestamp;
+                ++pushed;
+            } else {
+                ++dropped;
+                std::this_thread::yield();
+            }
+        }
+    });
+    Sample out{};
+    std::int64_t received = 0;
+    for (auto _ : state) {
+        while (!ring.pop(out)) {
+            std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(out);
+        ++received;
+    }
+    stop.store(true);
+    producer.join();
+    while (ring.pop(out)) {
+    }
+    state.SetItemsProcessed(received);
+    const double attempts = static_cast<double>(pushed + dropped);
+    state.counters["drop%"] = attempts > 0 ? 100.0 * static_cast<double>(dropped) / attempts : 0.0;
+}
+BENCHMARK(BM_SpscProducerConsumer)->UseRealTime();
+
+void BM_PoolAllocRelease(benchmark::State& state) {
+    static g7::BlockPool<64, 256> pool;
+    const std::uint64_t c0 = g7::cycles::now();
+    for (auto _ : state) {
+        void* p = pool.allocate();
+        benchmark::DoNotOptimize(p);
+        pool.release(p);
+    }
+    set_cycles_per_op(state, g7::cycles::now() - c0, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PoolAllocRelease);
+
+// Allocate the whole pool, then free it in reverse, to exercise list walks.
+void BM_PoolDrainRefill(benchmark::State& state) {
+    static g7::BlockPool<64, 256> pool;
+    void* blocks[256];
+    for (auto _ : state) {
+        for (auto& b : blocks) b = pool.allocate();
+        benchmark::DoNotOptimize(blocks);
+        for (std::size_t i = 256; i-- > 0;) pool.release(blocks[i]);
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_PoolDrainRefill);
+
+// Heap baseline for the two pool benchmarks above.
+void BM_HeapAllocRelease(benchmark::State& state) {
+    for (auto _ : state) {
+        void* p = ::operator new(64);
+        benchmark::DoNotOptimize(p);
+        ::operator delete(p);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HeapAllocRelease);
+
+void BM_HeapDrainRefill(benchmark::State& state) {
+    void* blocks[256];
+    for (auto _ : state) {
+        for (auto& b : blocks) b = ::operator new(64);
+        benchmark::DoNotOptimize(blocks);
+        for (std::size_t i = 256; i-- > 0;) ::operator delete(blocks[i]);
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_HeapDrainRefill);
+
+// Cost of the instrumentation itself, so it can be subtracted from readings.
+void BM_CycleScopeOverhead(benchmark::State& state) {
+    g7::CycleStat stat{"empty scope"};
+    for (auto _ : state) {
+        G7_CYCLE_SCOPE(stat);
+        benchmark::ClobberMemory();
+    }
+    state.counters["cycles/op"] = stat.mean();
+}
+BENCHMARK(BM_CycleScopeOverhead);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+// Fixed-block pool allocator.
+//
+// All storage is reserved inline when the pool is constructed; allocate() and
+// release() are O(1) pointer swaps on an intrusive free list and never call
+// into the heap. The pool is not internally locked: share it between an ISR
+// and a task only inside a critical section.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace g7 {
+
+template <std::size_t BlockSize, std::size_t BlockCount,
+          std::size_t Align = alignof(std::max_align_t)>
+class BlockPool {
+    static_assert(BlockCount > 0, "pool needs at least one block");
+    static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+
+    struct Node { Node* next; };
+
+public:
+    // Each block is padded so it can hold a free-list link and stay aligned.
+    static constexpr std::size_t kStride =
+        ((BlockSize < sizeof(Node) ? sizeof(Node) : BlockSize) + Align - 1) & ~(Align - 1);
+
+    BlockPool() { reset(); }
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    static constexpr std::size_t block_size() { return BlockSize; }
+    static constexpr std::size_t capacity() { return BlockCount; }
+    std::size_t available() const { return free_count_; }
+    // Lowest number of free blocks seen since reset(); use it to size the pool.
+    std::size_t low_watermark() const { return low_watermark_; }
+
+    // Returns nullptr when the pool is exhausted.
+    void* allocate() {
+        Node* n = free_;
+        if (n == nullptr) {
+            return nullptr;
+        }
+        free_ = n->next;
+        if (--free_count_ < low_watermark_) {
+            low_watermark_ = free_count_;
+        }
+        return n;
+    }
+
+    void release(void* p) {
+        if (p == nullptr) {
+            return;
+        }
+        Node* n = static_cast<Node*>(p);
+        n->next = free_;
+        free_ = n;
+        ++free_count_;
+    }
+
+    bool owns(const void* p) const {
+        const auto* b = reinterpret_cast<const unsigned char*>(p);
+        return b >= storage_ && b < storage_ + sizeof(storage_) &&
+               (static_cast<std::size_t>(b - storage_) % kStride) == 0;
+    }
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(sizeof(T) <= BlockSize, "type does not fit in a pool block");
+        static_assert(alignof(T) <= Align, "type is over-aligned for this pool");
+        void* p = allocate();
+        return p ? ::new (p) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    template <typename T>
+    void destroy(T* obj) {
+        if (obj != nullptr) {
+            obj->~T();
+            release(obj);
+        }
+    }
+
+    // Rebuilds the free list. Any outstanding blocks become invalid.
+    void reset() {
+        free_ = nullptr;
+        for (std::size_t i = BlockCount; i-- > 0;) {
+            Node* n = reinterpret_cast<Node*>(storage_ + i * kStride);
+            n->next = free_;
+            free_ = n;
+        }
+        free_count_ = BlockCount;
+        low_watermark_ = BlockCount;
+    }
+
+private:
+    alignas(Align) unsigned char storage_[kStride * BlockCount];
+    Node* free_ = nullptr;
+    std::size_t free_count_ = 0;
+    std::size_t low_watermark_ = 0;
+};
+
+}  // namespace g7
@@ -0,0 +1,116 @@
+// Cycle counter and timestamp instrumentation.
+//
+// g7::cycles::now() reads the cheapest monotonic counter available:
+//   - x86-64:      RDTSC
+//   - AArch64:     CNTVCT_EL0
+//   - Cortex-M3+:  DWT->CYCCNT (call cycles::enable() once at boot)
+//   - otherwise:   std::chrono::steady_clock in nanoseconds
+//
+// G7_CYCLE_SCOPE(stat) accumulates the cycles spent in the enclosing scope
+// into a g7::CycleStat. Define G7_INSTRUMENTATION=0 to compile it out.
+#pragma once
+
+#include <cstdint>
+
+#if !defined(G7_INSTRUMENTATION)
+#define G7_INSTRUMENTATION 1
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(__aarch64__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__)
+// Counter read inline below.
+#else
+#include <chrono>
+#endif
+
+namespace g7 {
+namespace cycles {
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+namespace detail {
+inline volatile std::uint32_t& dwt_ctrl() { return *reinterpret_cast<volatile std::uint32_t*>(0xE0001000u); }
+inline volatile std::uint32_t& dwt_cyccnt() { return *reinterpret_cast<volatile std::uint32_t*>(0xE0001004u); }
+inline volatile std::uint32_t& dcb_demcr() { return *reinterpret_cast<volatile std::uint32_t*>(0xE000EDFCu); }
+}  // namespace detail
+#endif
+
+// Starts the hardware counter where that is needed. Safe to call repeatedly.
+inline void enable() {
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    detail::dcb_demcr() |= (1u << 24);  // TRCENA
+    detail::dwt_cyccnt() = 0;
+    detail::dwt_ctrl() |= 1u;           // CYCCNTENA
+#endif
+}
+
+inline std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    return detail::dwt_cyccnt();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Counter ticks per second. Measured once against steady_clock on hosts;
+// on Cortex-M it returns the value passed to set_frequency() (the core clock).
+double frequency();
+void set_frequency(double hz);
+
+inline double to_ns(std::uint64_t ticks) { return static_cast<double>(ticks) * 1e9 / frequency(); }
+
+}  // namespace cycles
+
+// Running min/max/sum of cycle counts for one instrumented region.
+struct CycleStat {
+    const char* name = "";
+    std::uint64_t count = 0;
+    std::uint64_t total = 0;
+    std::uint64_t min = ~std::uint64_t{0};
+    std::uint64_t max = 0;
+
+    void add(std::uint64_t c) {
+        ++count;
+        total += c;
+        if (c < min) min = c;
+        if (c > max) max = c;
+    }
+    double mean() const { return count ? static_cast<double>(total) / static_cast<double>(count) : 0.0; }
+    void reset() { *this = CycleStat{name}; }
+};
+
+class CycleScope {
+public:
+    explicit CycleScope(CycleStat& s) : stat_(s), start_(cycles::now()) {}
+    ~CycleScope() { stat_.add(cycles::now() - start_); }
+    CycleScope(const CycleScope&) = delete;
+    CycleScope& operator=(const CycleScope&) = delete;
+
+private:
+    CycleStat& stat_;
+    std::uint64_t start_;
+};
+
+// Prints "name: n=.. min=.. mean=.. max=.. cycles" to stdout.
+void print(const CycleStat& s);
+
+}  // namespace g7
+
+#define G7_CAT_IMPL(a, b) a##b
+#define G7_CAT(a, b) G7_CAT_IMPL(a, b)
+
+#if G7_INSTRUMENTATION
+#define G7_TIMESTAMP() ::g7::cycles::now()
+#define G7_CYCLE_SCOPE(stat) ::g7::CycleScope G7_CAT(g7_cycle_scope_, __LINE__)(stat)
+#else
+#define G7_TIMESTAMP() std::uint64_t{0}
+#define G7_CYCLE_SCOPE(stat) static_cast<void>(stat)
+#endif
@@ -0,0 +1,111 @@
+// Log-linear latency histogram.
+//
+// Values are bucketed by power of two with 16 linear sub-buckets each, so any
+// reported percentile is within ~6% of the true value across the full 64-bit
+// range. Storage is a fixed ~8 KB array and add() is a few integer ops; this
+// is meant for host-side reports, not for a Cortex-M with 20 KB of RAM.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace g7 {
+
+class Histogram {
+public:
+    static constexpr int kSubBits = 4;
+    static constexpr std::uint64_t kSub = 1u << kSubBits;
+    static constexpr std::size_t kBuckets = (64 - kSubBits + 1) * kSub;
+
+    void add(std::uint64_t v) {
+        ++counts_[index(v)];
+        ++count_;
+        sum_ += v;
+        if (v < min_) min_ = v;
+        if (v > max_) max_ = v;
+    }
+
+    void merge(const Histogram& o) {
+        for (std::size_t i = 0; i < kBuckets; ++i) counts_[i] += o.counts_[i];
+        count_ += o.count_;
+        sum_ += o.sum_;
+        if (o.min_ < min_) min_ = o.min_;
+        if (o.max_ > max_) max_ = o.max_;
+    }
+
+    void reset() { *this = Histogram{}; }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    // Upper edge of the bucket holding the p-th percentile (0 < p <= 100),
+    // clamped to the observed maximum.
+    std::uint64_t percentile(double p) const {
+        if (count_ == 0) return 0;
+        auto rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(count_) + 0.5);
+        if (rank < 1) rank = 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                const std::uint64_t hi = upper(i);
+                return hi < max_ ? hi : max_;
+            }
+        }
+        return max_;
+    }
+
+    // One line per occupied power-of-two range with a proportional bar.
+    void print_bars(std::FILE* out, const char* unit, int width = 40) const {
+        std::uint64_t rows[65] = {};
+        std::uint64_t peak = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            if (counts_[i] == 0) continue;
+            const int row = msb(lower(i)) + 1;
+            rows[row] += counts_[i];
+            if (rows[row] > peak) peak = rows[row];
+        }
+        for (int r = 0; r <= 64; ++r) {
+            if (rows[r] == 0) continue;
+            const std::uint64_t lo = r == 0 ? 0 : std::uint64_t{1} << (r - 1);
+            const std::uint64_t hi = r == 0 ? 0 : r == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << r) - 1;
+            const int bar = static_cast<int>(rows[r] * static_cast<std::uint64_t>(width) / peak);
+            std::fprintf(out, "  %10llu .. %-10llu %-3s |%-*.*s| %llu\n",
+                         static_cast<unsigned long long>(lo), static_cast<unsigned long long>(hi), unit,
+                         width, bar, "########################################################################",
+                         static_cast<unsigned long long>(rows[r]));
+        }
+    }
+
+private:
+    static int msb(std::uint64_t v) { return v ? 63 - __builtin_clzll(v) : -1; }
+
+    static std::size_t index(std::uint64_t v) {
+        if (v < kSub) return static_cast<std::size_t>(v);
+        const int shift = msb(v) - kSubBits;
+        return static_cast<std::size_t>(shift + 1) * kSub + static_cast<std::size_t>((v >> shift) - kSub);
+    }
+
+    static std::uint64_t lower(std::size_t i) {
+        if (i < kSub) return i;
+        const std::size_t shift = i / kSub - 1;
+        return (kSub + i % kSub) << shift;
+    }
+
+    static std::uint64_t upper(std::size_t i) {
+        if (i < kSub) return i;
+        const std::size_t shift = i / kSub - 1;
+        return ((kSub + i % kSub + 1) << shift) - 1;
+    }
+
+    std::uint64_t counts_[kBuckets] = {};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = ~std::uint64_t{0};
+    std::uint64_t max_ = 0;
+};
+
+}  // namespace g7
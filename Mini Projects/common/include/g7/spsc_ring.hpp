@@ -0,0 +1,109 @@
+// Lock-free single-producer / single-consumer ring buffer.
+//
+// Intended for handing samples from an ISR (producer) to a task (consumer)
+// without disabling interrupts. Exactly one context may call the push side
+// and exactly one context may call the pop side. Storage is inline, so the
+// ring never allocates.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace g7 {
+
+// Cache line size used to keep producer and consumer indices apart. On
+// Cortex-M parts without a data cache this only costs a few bytes of padding.
+inline constexpr std::size_t kCacheLine = 64;
+
+template <typename T, std::size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "ring elements are copied by value");
+
+public:
+    static constexpr std::size_t capacity() { return N; }
+
+    // Producer side. Returns false when the ring is full (the sample is
+    // dropped and the caller should count it).
+    bool push(const T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ == N) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ == N) {
+                return false;
+            }
+        }
+        buf_[head & kMask] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side. Copies up to `count` elements and returns how many fit.
+    std::size_t push(const T* values, std::size_t count) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t room = N - (head - tail_cache_);
+        if (room < count) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            room = N - (head - tail_cache_);
+        }
+        const std::size_t n = count < room ? count : room;
+        for (std::size_t i = 0; i < n; ++i) {
+            buf_[(head + i) & kMask] = values[i];
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side. Returns false when the ring is empty.
+    bool pop(T& out) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) {
+                return false;
+            }
+        }
+        out = buf_[tail & kMask];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Copies up to `count` elements and returns how many were read.
+    std::size_t pop(T* out, std::size_t count) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t avail = head_cache_ - tail;
+        if (avail < count) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            avail = head_cache_ - tail;
+        }
+        const std::size_t n = count < avail ? count : avail;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = buf_[(tail + i) & kMask];
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Approximate fill level; exact only when called from one of the two sides
+    // while the other is idle.
+    std::size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+private:
+    static constexpr std::size_t kMask = N - 1;
+
+    // Producer-owned line: write index plus its cached view of the consumer.
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+    // Consumer-owned line.
+    alignas(kCacheLine) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+
+    alignas(kCacheLine) T buf_[N];
+};
+
+}  // namespace g7
@@ -0,0 +1,61 @@
+#include "g7/cycles.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#include <chrono>
+#endif
+
+namespace g7 {
+namespace cycles {
+
+namespace {
+
+double g_frequency = 0.0;
+
+double calibrate() {
+#if defined(__aarch64__)
+    std::uint64_t f;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(f));
+    return static_cast<double>(f);
+#elif defined(__x86_64__) || defined(__i386__)
+    // Spin for ~20 ms and compare TSC ticks against steady_clock.
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    const std::uint64_t c0 = now();
+    auto t1 = t0;
+    while (t1 - t0 < std::chrono::milliseconds(20)) {
+        t1 = clock::now();
+    }
+    const std::uint64_t c1 = now();
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(c1 - c0) / secs;
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    // No reference clock to compare against; assume a common default until
+    // set_frequency() is called with SystemCoreClock.
+    return 16e6;
+#else
+    return 1e9;  // steady_clock nanoseconds
+#endif
+}
+
+}  // namespace
+
+double frequency() {
+    if (g_frequency == 0.0) {
+        g_frequency = calibrate();
+    }
+    return g_frequency;
+}
+
+void set_frequency(double hz) { g_frequency = hz; }
+
+}  // namespace cycles
+
+void print(const CycleStat& s) {
+    std::printf("%-24s n=%-8" PRIu64 " min=%-8" PRIu64 " mean=%-10.1f max=%-8" PRIu64 " cycles\n",
+                s.name, s.count, s.count ? s.min : 0, s.mean(), s.max);
+}
+
+}  // namespace g7
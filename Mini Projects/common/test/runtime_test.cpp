@@ -0,0 +1,114 @@
+// Runtime checks: SPSC ring order and completeness across threads, including
+// bulk transfers that wrap, block pool exhaustion and refill, and histogram
+// percentile accuracy.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "g7/block_pool.hpp"
+#include "g7/histogram.hpp"
+#include "g7/spsc_ring.hpp"
+
+namespace {
+
+bool g_ok = true;
+
+void report(bool pass, const char* what) {
+    std::printf("%s %s\n", pass ? "ok      " : "MISMATCH", what);
+    g_ok = g_ok && pass;
+}
+
+// One producer pushes 0..n-1 in bursts of varying size; the consumer must
+// see every value once and in order.
+void ring_threads() {
+    constexpr std::uint32_t n = 1000000;
+    static g7::SpscRing<std::uint32_t, 256> ring;
+    std::thread producer([] {
+        std::uint32_t buf[37];
+        for (std::uint32_t next = 0; next < n;) {
+            const std::uint32_t want = 1 + next % 37;
+            std::uint32_t count = 0;
+            for (; count < want && next + count < n; ++count) buf[count] = next + count;
+            std::size_t done = 0;
+            while (done < count) {
+                const std::size_t k = ring.push(buf + done, count - done);
+                if (k == 0) std::this_thread::yield();
+                done += k;
+            }
+            next += count;
+        }
+    });
+    bool ordered = true;
+    std::uint32_t expect = 0;
+    std::uint32_t buf[64];
+    while (expect < n) {
+        std::size_t k = 0;
+        if (expect % 3 == 0) {
+            k = ring.pop(buf, 1 + expect % 64);
+        } else if (ring.pop(buf[0])) {
+            k = 1;
+        }
+        if (k == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t i = 0; i < k; ++i) ordered = ordered && buf[i] == expect++;
+    }
+    producer.join();
+    report(ordered && ring.empty(), "spsc ring: 1M values across threads, in order");
+}
+
+void ring_full() {
+    g7::SpscRing<int, 8> ring;
+    int pushed = 0;
+    while (ring.push(pushed)) ++pushed;
+    int v = -1;
+    const bool first = ring.pop(v) && v == 0;
+    const bool refill = ring.push(100) && !ring.push(101);
+    report(pushed == 8 && ring.size() == 8 && first && refill, "spsc ring: full at capacity, one pop frees a slot");
+}
+
+void pool() {
+    g7::BlockPool<48, 16> p;
+    std::vector<void*> blocks;
+    while (void* b = p.allocate()) blocks.push_back(b);
+    const std::set<void*> unique(blocks.begin(), blocks.end());
+    bool owned = true;
+    for (void* b : blocks) {
+        owned = owned && p.owns(b) && reinterpret_cast<std::uintptr_t>(b) % alignof(std::max_align_t) == 0;
+    }
+    const bool exhausted = blocks.size() == 16 && unique.size() == 16 && p.available() == 0 && p.low_watermark() == 0;
+    for (void* b : blocks) p.release(b);
+    bool refilled = p.available() == 16;
+    for (int i = 0; i < 16; ++i) refilled = refilled && unique.count(p.allocate()) == 1;
+    int on_stack = 0;
+    report(exhausted && owned && refilled && !p.owns(&on_stack) && !p.owns(static_cast<char*>(blocks[0]) + 1),
+           "block pool: 16 distinct aligned blocks, then empty, then refilled");
+}
+
+void histogram() {
+    g7::Histogram h;
+    for (std::uint64_t v = 1; v <= 100000; ++v) h.add(v);
+    // Buckets are 1/16 of a power of two wide, so within ~6% above.
+    auto near = [](std::uint64_t got, std::uint64_t want) { return got >= want && got <= want + want / 16 + 1; };
+    const bool pct = near(h.percentile(50), 50000) && near(h.percentile(99), 99000) && h.percentile(100) == 100000;
+    g7::Histogram other;
+    other.add(7);
+    h.merge(other);
+    report(pct && h.count() == 100001 && h.min() == 1 && h.max() == 100000,
+           "histogram: percentiles within one sub-bucket, merge");
+}
+
+}  // namespace
+
+int main() {
+    ring_threads();
+    ring_full();
+    pool();
+    histogram();
+    return g_ok ? 0 : 1;
+}
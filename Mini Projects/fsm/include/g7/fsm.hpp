@@ -0,0 +1,7 @@
+// Umbrella header for the state machine framework.
+#pragma once
+
+#include "g7/fsm/chart.hpp"
+#include "g7/fsm/event_queue.hpp"
+#include "g7/fsm/loop.hpp"
+#include "g7/fsm/machine.hpp"
@@ -0,0 +1,114 @@
+// Compile-time hierarchical state charts.
+//
+//   enum : g7::fsm::StateId { kRunning, kIdle, kBusy, kStateCount };
+//   enum : g7::fsm::EventId { kStart, kDone, kEventCount };
+//
+//   inline constexpr g7::fsm::Chart<Ctx, kStateCount, 2, kEventCount> kChart{
+//       kRunning,
+//       {{{.name = "running", .initial = kIdle},
+//         {.name = "idle", .parent = kRunning},
+//         {.name = "busy", .parent = kRunning, .deepest = Power::Sleep, .entry = start_dma}}},
+//       {{{.from = kIdle, .event = kStart, .to = kBusy},
+//         {.from = kBusy, .event = kDone, .to = kIdle, .action = log_done}}}};
+//   static_assert(kChart.valid());
+//
+// A state's id is its index in `states`. `parent` nests it inside another
+// state; `initial` names the child entered when a transition targets it.
+// A transition is looked up on the active leaf first, then on each
+// ancestor, so an outer state handles what its children leave alone. Among
+// transitions of one state for one event, the first whose guard passes
+// fires. A transition without a target is internal: it runs its action and
+// nothing is exited or entered. Otherwise it is external: states are exited
+// up to the nearest state enclosing both source and target, the action
+// runs, and the target is entered down to a leaf through `initial`.
+//
+// Handlers are plain function pointers, usually captureless lambdas, so a
+// chart is constexpr data that can live in flash. Machine (machine.hpp)
+// takes one as a template argument and derives its lookup tables at
+// compile time.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/fsm/event_queue.hpp"
+
+namespace g7::fsm {
+
+using StateId = std::uint8_t;
+
+inline constexpr StateId kNoState = 0xFF;
+inline constexpr std::size_t kMaxDepth = 8;
+
+// Low-power modes, shallowest first.
+//   Run    the core stays awake and spins
+//   Sleep  WFI: the core clock stops, peripheral clocks keep running
+//   Stop   SLEEPDEEP: high-speed clocks stop, RAM is kept; only low-power
+//          timers and external interrupts can wake the core
+enum class Power : std::uint8_t { Run, Sleep, Stop };
+
+template <class Ctx>
+struct State {
+    const char* name = "";
+    StateId parent = kNoState;
+    StateId initial = kNoState;
+    // Deepest mode allowed while this state is active. A child never sleeps
+    // deeper than its parent allows.
+    Power deepest = Power::Stop;
+    void (*entry)(Ctx&) = nullptr;
+    void (*exit)(Ctx&) = nullptr;
+};
+
+template <class Ctx>
+struct Transition {
+    StateId from = kNoState;
+    EventId event = 0;
+    StateId to = kNoState;  // kNoState: internal transition
+    bool (*guard)(const Ctx&, const Event&) = nullptr;
+    void (*action)(Ctx&, const Event&) = nullptr;
+};
+
+template <class Ctx, std::size_t NS, std::size_t NT, std::size_t NE>
+struct Chart {
+    static_assert(NS >= 1 && NS < kNoState, "a chart has 1..254 states");
+    static_assert(NE >= 1 && NE <= 256, "event ids are 8 bits");
+    static_assert(NT < 0xFFFF, "too many transitions");
+
+    using Context = Ctx;
+    static constexpr std::size_t kStates = NS;
+    static constexpr std::size_t kTransitions = NT;
+    static constexpr std::size_t kEvents = NE;
+
+    StateId initial;
+    std::array<State<Ctx>, NS> states;
+    std::array<Transition<Ctx>, NT> transitions;
+
+    // Nesting depth of `s`: 1 for a top-level state, 0 for kNoState or a
+    // state inside a parent cycle.
+    constexpr std::size_t depth(StateId s) const {
+        std::size_t d = 0;
+        for (; s != kNoState; s = states[s].parent) {
+            if (s >= NS || ++d > kMaxDepth) return 0;
+        }
+        return d;
+    }
+
+    // Parents form a forest no deeper than kMaxDepth, every `initial` is a
+    // direct child, and every transition names known states and events.
+    constexpr bool valid() const {
+        if (initial >= NS) return false;
+        for (std::size_t i = 0; i < NS; ++i) {
+            const State<Ctx>& s = states[i];
+            if (depth(static_cast<StateId>(i)) == 0) return false;
+            if (s.initial != kNoState && (s.initial >= NS || states[s.initial].parent != i)) return false;
+        }
+        for (const Transition<Ctx>& t : transitions) {
+            if (t.from >= NS || t.event >= NE) return false;
+            if (t.to != kNoState && t.to >= NS) return false;
+        }
+        return true;
+    }
+};
+
+}  // namespace g7::fsm
@@ -0,0 +1,99 @@
+// Events and the interrupt-fed event queue.
+//
+// Interrupt handlers post events; the main loop pops them and feeds them to
+// the state machine one at a time. Several handlers at different priorities
+// may post, and may preempt one another mid-post, so the queue is
+// multi-producer / single-consumer. Each slot carries a sequence number
+// (Vyukov's bounded queue): a producer claims a slot with one CAS on the
+// write index and publishes it with a release store. A producer preempted
+// between the two leaves a hole the consumer waits behind, but on one core
+// the preempting code always finishes before thread mode runs again.
+//
+// On Cortex-M3 and up the CAS is LDREX/STREX. Cortex-M0 has no CAS, so its
+// std::atomic falls back to masking interrupts around it.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/spsc_ring.hpp"
+
+namespace g7::fsm {
+
+using EventId = std::uint8_t;
+
+// Small and trivially copyable, so queues copy it by value. `arg` carries
+// the payload, e.g. an ADC result or a byte count.
+struct Event {
+    EventId id = 0;
+    std::uint32_t arg = 0;
+};
+
+template <std::size_t N>
+class EventQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    static constexpr std::size_t capacity() { return N; }
+
+    EventQueue() {
+        for (std::size_t i = 0; i < N; ++i) slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Any context, including nested interrupt handlers. Returns false when
+    // the queue is full; the event is dropped and counted.
+    bool post(const Event& e) {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& s = slots_[pos & kMask];
+            const std::size_t seq = s.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    s.event = e;
+                    s.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    bool post(EventId id, std::uint32_t arg = 0) { return post(Event{id, arg}); }
+
+    // Consumer only. Returns false when empty.
+    bool pop(Event& out) {
+        Slot& s = slots_[tail_ & kMask];
+        if (s.seq.load(std::memory_order_acquire) != tail_ + 1) return false;
+        out = s.event;
+        s.seq.store(tail_ + N, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    // Consumer only.
+    bool empty() const { return slots_[tail_ & kMask].seq.load(std::memory_order_acquire) != tail_ + 1; }
+    std::uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kMask = N - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        Event event;
+    };
+
+    // Producers share the write index; the consumer owns the read index.
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0};
+    std::atomic<std::uint32_t> dropped_{0};
+    alignas(kCacheLine) std::size_t tail_ = 0;
+    Slot slots_[N];
+};
+
+}  // namespace g7::fsm
@@ -0,0 +1,36 @@
+// Event loop: drain the queue, then sleep as deep as the active states allow.
+//
+//   for (;;) g7::fsm::run_once(machine, queue, port);
+//
+// `port` is the board's low-power hook, called with the mode to enter:
+//
+//   void sleep(g7::fsm::Power mode, const EventQueue<N>& queue);
+//
+// It must return at once if the queue is no longer empty. On target, mask
+// interrupts, test queue.empty(), set or clear SLEEPDEEP for the mode and
+// execute WFI, then unmask: an event posted after the test still wakes the
+// core, and its handler runs once interrupts are unmasked. Power::Run
+// returns without sleeping.
+#pragma once
+
+#include <cstddef>
+
+#include "g7/fsm/event_queue.hpp"
+
+namespace g7::fsm {
+
+// Dispatches every queued event, then sleeps once. Returns the number of
+// events dispatched.
+template <class M, std::size_t N, class Port>
+std::size_t run_once(M& machine, EventQueue<N>& queue, Port& port) {
+    std::size_t n = 0;
+    Event e;
+    while (queue.pop(e)) {
+        machine.dispatch(e);
+        ++n;
+    }
+    port.sleep(machine.sleep_mode(), queue);
+    return n;
+}
+
+}  // namespace g7::fsm
@@ -0,0 +1,217 @@
+// State machine driven by a compile-time chart.
+//
+//   Ctx ctx;
+//   g7::fsm::Machine<kChart> m(ctx);
+//   m.start();           // enters kChart.initial down to a leaf
+//   m.dispatch(event);   // false if no transition took it
+//
+// Everything that depends only on the chart is worked out at compile time:
+//
+//   - for each state and event, the chain of candidate transitions: the
+//     state's own, then each ancestor's, in table order;
+//   - for each transition, the enclosing state where exits stop and the
+//     list of states to enter;
+//   - for each state, the deepest low-power mode its ancestors allow.
+//
+// dispatch() is then a table lookup, one guard call per candidate, and the
+// exit and entry calls themselves. Nothing is virtual and nothing
+// allocates. Dispatch is run-to-completion: handlers must not call
+// dispatch() themselves, but may post to an EventQueue.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "g7/fsm/chart.hpp"
+
+namespace g7::fsm {
+
+namespace detail {
+
+using TransitionIndex = std::uint16_t;
+inline constexpr TransitionIndex kNoTransition = 0xFFFF;
+
+template <std::size_t NS, std::size_t NT, std::size_t NE>
+struct Tables {
+    std::array<Power, NS> sleep{};
+    std::array<TransitionIndex, NS * NE> first{};
+    std::array<TransitionIndex, NT> next{};
+    std::array<StateId, NT> domain{};
+    std::array<std::uint8_t, NT> enter_count{};
+    std::array<StateId, NT * kMaxDepth> enter{};
+    std::array<StateId, kMaxDepth> start{};
+    std::uint8_t start_count = 0;
+};
+
+// States to enter, outermost first, going from just below `domain` to
+// `target` and then down its initial children.
+template <class C>
+constexpr std::size_t entry_path(const C& c, StateId domain, StateId target, StateId* out) {
+    StateId up[kMaxDepth] = {};
+    std::size_t n = 0;
+    for (StateId s = target; s != domain; s = c.states[s].parent) up[n++] = s;
+    std::size_t k = 0;
+    while (n > 0) out[k++] = up[--n];
+    for (StateId s = c.states[target].initial; s != kNoState; s = c.states[s].initial) out[k++] = s;
+    return k;
+}
+
+// Deepest state enclosing both `a` and `b`, or kNoState at the top.
+template <class C>
+constexpr StateId common_ancestor(const C& c, StateId a, StateId b) {
+    auto depth = [&](StateId s) { return s == kNoState ? std::size_t{0} : c.depth(s); };
+    auto parent = [&](StateId s) { return s == kNoState ? kNoState : c.states[s].parent; };
+    while (depth(a) > depth(b)) a = parent(a);
+    while (depth(b) > depth(a)) b = parent(b);
+    while (a != b) {
+        a = parent(a);
+        b = parent(b);
+    }
+    return a;
+}
+
+template <const auto& C>
+constexpr auto build_tables() {
+    using ChartType = std::remove_cvref_t<decltype(C)>;
+    constexpr std::size_t NS = ChartType::kStates;
+    constexpr std::size_t NT = ChartType::kTransitions;
+    constexpr std::size_t NE = ChartType::kEvents;
+    Tables<NS, NT, NE> t;
+
+    // States by depth, so parents are resolved before their children.
+    std::array<StateId, NS> order{};
+    std::size_t n = 0;
+    for (std::size_t d = 1; d <= kMaxDepth; ++d) {
+        for (std::size_t s = 0; s < NS; ++s) {
+            if (C.depth(static_cast<StateId>(s)) == d) order[n++] = static_cast<StateId>(s);
+        }
+    }
+
+    // A state's own first transition per event, and the next one of the
+    // same state and event.
+    std::array<TransitionIndex, NS * NE> own{};
+    own.fill(kNoTransition);
+    t.next.fill(kNoTransition);
+    for (std::size_t i = NT; i-- > 0;) {
+        const auto& tr = C.transitions[i];
+        TransitionIndex& head = own[tr.from * NE + tr.event];
+        t.next[i] = head;
+        head = static_cast<TransitionIndex>(i);
+    }
+
+    // Chains continue into the nearest ancestor that handles the event.
+    for (StateId s : order) {
+        const StateId p = C.states[s].parent;
+        t.sleep[s] = C.states[s].deepest;
+        if (p != kNoState && t.sleep[p] < t.sleep[s]) t.sleep[s] = t.sleep[p];
+        for (std::size_t e = 0; e < NE; ++e) {
+            const TransitionIndex inherited = p == kNoState ? kNoTransition : t.first[p * NE + e];
+            const TransitionIndex mine = own[s * NE + e];
+            t.first[s * NE + e] = mine == kNoTransition ? inherited : mine;
+        }
+    }
+    for (std::size_t i = 0; i < NT; ++i) {
+        if (t.next[i] != kNoTransition) continue;
+        const auto& tr = C.transitions[i];
+        const StateId p = C.states[tr.from].parent;
+        t.next[i] = p == kNoState ? kNoTransition : t.first[p * NE + tr.event];
+    }
+
+    // External transitions leave the source itself, even when the target
+    // is inside it.
+    for (std::size_t i = 0; i < NT; ++i) {
+        const auto& tr = C.transitions[i];
+        if (tr.to == kNoState) continue;
+        const StateId d = common_ancestor(C, C.states[tr.from].parent, C.states[tr.to].parent);
+        t.domain[i] = d;
+        t.enter_count[i] = static_cast<std::uint8_t>(entry_path(C, d, tr.to, &t.enter[i * kMaxDepth]));
+    }
+    t.start_count = static_cast<std::uint8_t>(entry_path(C, kNoState, C.initial, t.start.data()));
+    return t;
+}
+
+}  // namespace detail
+
+template <const auto& C>
+class Machine {
+    using ChartType = std::remove_cvref_t<decltype(C)>;
+    static_assert(C.valid(), "invalid state chart");
+
+public:
+    using Context = typename ChartType::Context;
+    static constexpr std::size_t kEvents = ChartType::kEvents;
+
+    explicit Machine(Context& ctx) : ctx_(ctx) {}
+    Machine(const Machine&) = delete;
+    Machine& operator=(const Machine&) = delete;
+
+    // Enters the chart's initial state and its initial children.
+    void start() { enter(kTables.start.data(), kTables.start_count); }
+
+    // Runs the first enabled transition for `e`. Returns false, and counts
+    // the event, when no active state handles it, including before start().
+    bool dispatch(const Event& e) {
+        if (cur_ != kNoState && e.id < kEvents) {
+            auto t = kTables.first[cur_ * kEvents + e.id];
+            for (; t != detail::kNoTransition; t = kTables.next[t]) {
+                const auto& tr = C.transitions[t];
+                if (tr.guard == nullptr || tr.guard(ctx_, e)) {
+                    fire(t, e);
+                    return true;
+                }
+            }
+        }
+        ++unhandled_;
+        return false;
+    }
+    bool dispatch(EventId id, std::uint32_t arg = 0) { return dispatch(Event{id, arg}); }
+
+    // The active leaf; kNoState before start().
+    StateId current() const { return cur_; }
+    // True if `s` is the active leaf or one of its ancestors.
+    bool in(StateId s) const {
+        for (StateId a = cur_; a != kNoState; a = C.states[a].parent) {
+            if (a == s) return true;
+        }
+        return false;
+    }
+    const char* state_name() const { return cur_ == kNoState ? "" : C.states[cur_].name; }
+
+    // Deepest low-power mode the active states allow.
+    Power sleep_mode() const { return cur_ == kNoState ? Power::Run : kTables.sleep[cur_]; }
+
+    std::uint32_t unhandled() const { return unhandled_; }
+    Context& context() { return ctx_; }
+
+private:
+    static constexpr auto kTables = detail::build_tables<C>();
+
+    void fire(std::size_t t, const Event& e) {
+        const auto& tr = C.transitions[t];
+        if (tr.to == kNoState) {
+            if (tr.action != nullptr) tr.action(ctx_, e);
+            return;
+        }
+        const StateId domain = kTables.domain[t];
+        for (StateId s = cur_; s != domain; s = C.states[s].parent) {
+            if (C.states[s].exit != nullptr) C.states[s].exit(ctx_);
+        }
+        if (tr.action != nullptr) tr.action(ctx_, e);
+        enter(&kTables.enter[t * kMaxDepth], kTables.enter_count[t]);
+    }
+
+    void enter(const StateId* path, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            cur_ = path[i];
+            if (C.states[cur_].entry != nullptr) C.states[cur_].entry(ctx_);
+        }
+    }
+
+    Context& ctx_;
+    StateId cur_ = kNoState;
+    std::uint32_t unhandled_ = 0;
+};
+
+}  // namespace g7::fsm
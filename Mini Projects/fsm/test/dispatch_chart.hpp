@@ -0,0 +1,76 @@
+// The dispatch benchmark chart, shared by the fsm test and benchmarks.
+//
+//   Root
+//   +-- A (Sleep)
+//   |   +-- A1 -- A11 -- A111
+//   |               +--- A112
+//   +-- B
+//       +-- B1 -- B11 -- B111 (Run)
+//
+// Every state counts its entries and exits and, when `trace` is set, appends
+// them to it as " +Name" and " -Name".
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "g7/fsm.hpp"
+
+namespace g7::fsm::test {
+
+enum : StateId { kRoot, kA, kA1, kA11, kA111, kA112, kB, kB1, kB11, kB111, kStateCount };
+enum : EventId { kPing, kToggle, kCross, kBubble, kGuarded, kReset, kUnknown, kEventCount };
+
+inline constexpr const char* kNames[kStateCount] = {"Root", "A", "A1", "A11", "A111", "A112", "B", "B1", "B11", "B111"};
+
+struct Ctx {
+    std::uint64_t entries = 0;
+    std::uint64_t exits = 0;
+    std::uint64_t actions = 0;
+    int gate = 0;
+    std::string* trace = nullptr;
+};
+
+template <StateId S>
+inline void on_entry(Ctx& c) {
+    ++c.entries;
+    if (c.trace != nullptr) c.trace->append(" +").append(kNames[S]);
+}
+
+template <StateId S>
+inline void on_exit(Ctx& c) {
+    ++c.exits;
+    if (c.trace != nullptr) c.trace->append(" -").append(kNames[S]);
+}
+
+inline void count(Ctx& c, const Event&) { ++c.actions; }
+
+template <StateId S, StateId Parent, StateId Initial = kNoState, Power Deepest = Power::Stop>
+inline constexpr State<Ctx> bench_state() {
+    return {kNames[S], Parent, Initial, Deepest, &on_entry<S>, &on_exit<S>};
+}
+
+inline constexpr Chart<Ctx, kStateCount, 12, kEventCount> kChart{
+    kRoot,
+    {{bench_state<kRoot, kNoState, kA>(), bench_state<kA, kRoot, kA1, Power::Sleep>(), bench_state<kA1, kA, kA11>(),
+      bench_state<kA11, kA1, kA111>(), bench_state<kA111, kA11>(), bench_state<kA112, kA11>(), bench_state<kB, kRoot, kB1>(),
+      bench_state<kB1, kB, kB11>(), bench_state<kB11, kB1, kB111>(), bench_state<kB111, kB11, kNoState, Power::Run>()}},
+    {{
+        {.from = kA111, .event = kPing, .action = count},
+        {.from = kA111, .event = kToggle, .to = kA112},
+        {.from = kA112, .event = kToggle, .to = kA111},
+        {.from = kA111, .event = kCross, .to = kB111},
+        {.from = kA112, .event = kCross, .to = kB111},
+        {.from = kB111, .event = kCross, .to = kA111},
+        {.from = kRoot, .event = kBubble, .action = count},
+        {.from = kA111, .event = kGuarded, .to = kA112, .guard = [](const Ctx& c, const Event&) { return c.gate == 1; }},
+        {.from = kA111, .event = kGuarded, .to = kB111, .guard = [](const Ctx& c, const Event&) { return c.gate == 2; }},
+        {.from = kA11, .event = kGuarded, .guard = [](const Ctx& c, const Event&) { return c.gate == 3; }},
+        {.from = kA, .event = kGuarded, .action = count},
+        {.from = kA, .event = kReset, .to = kA},
+    }}};
+static_assert(kChart.valid());
+
+using BenchMachine = Machine<kChart>;
+
+}  // namespace g7::fsm::test
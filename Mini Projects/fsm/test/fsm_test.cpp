@@ -0,0 +1,116 @@
+// State machine checks: entry/exit order, guard fallback to outer states,
+// internal and self transitions, per-state sleep limits, the event queue
+// under concurrent producers, and that all three sensor-node firmwares do
+// the same work.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dispatch_chart.hpp"
+#include "g7/fsm.hpp"
+#include "sensor_node.hpp"
+
+using namespace g7::fsm;
+using namespace g7::fsm::test;
+
+namespace {
+
+int check() {
+    bool ok = true;
+    auto report = [&](bool pass, const char* what, const std::string& detail) {
+        std::printf("%s %-34s %s\n", pass ? "ok      " : "MISMATCH", what, detail.c_str());
+        ok = ok && pass;
+    };
+
+    std::string trace;
+    Ctx ctx;
+    ctx.trace = &trace;
+    BenchMachine m(ctx);
+    const bool early = !m.dispatch(kToggle) && m.unhandled() == 1 && m.current() == kNoState && trace.empty();
+    report(early, "dispatch before start() dropped", std::to_string(m.unhandled()));
+    auto step = [&](EventId e, const char* want, StateId leaf) {
+        trace.clear();
+        const bool handled = m.dispatch(e);
+        report(handled && trace == want && m.current() == leaf, "transition order",
+               trace.empty() ? "(none)" : trace.substr(1));
+    };
+    m.start();
+    report(trace == " +Root +A +A1 +A11 +A111" && m.current() == kA111, "start enters initial leaf", trace.substr(1));
+    step(kToggle, " -A111 +A112", kA112);
+    step(kCross, " -A112 -A11 -A1 -A +B +B1 +B11 +B111", kB111);
+    step(kCross, " -B111 -B11 -B1 -B +A +A1 +A11 +A111", kA111);
+    step(kReset, " -A111 -A11 -A1 -A +A +A1 +A11 +A111", kA111);
+
+    const std::uint64_t actions = ctx.actions;
+    step(kBubble, "", kA111);
+    ctx.gate = 0;
+    step(kGuarded, "", kA111);
+    ctx.gate = 3;
+    step(kGuarded, "", kA111);
+    report(ctx.actions == actions + 2, "internal and guarded fallback", std::to_string(ctx.actions - actions) + " actions");
+    ctx.gate = 2;
+    step(kGuarded, " -A111 -A11 -A1 -A +B +B1 +B11 +B111", kB111);
+    const bool dropped = !m.dispatch(kUnknown) && !m.dispatch(EventId{200});
+    report(dropped && m.unhandled() == 3, "unhandled events counted", std::to_string(m.unhandled()));
+
+    bool modes = m.sleep_mode() == Power::Run;
+    m.dispatch(kCross);
+    modes = modes && m.sleep_mode() == Power::Sleep && m.in(kA) && m.in(kRoot) && !m.in(kB);
+    report(modes, "sleep mode follows active states", "A111 under A: sleep, B111: run");
+
+    // Four producers racing one consumer; each producer's events must come
+    // out complete and in order.
+    {
+        constexpr std::uint32_t kProducers = 4;
+        constexpr std::uint32_t kPerProducer = 100000;
+        EventQueue<64> q;
+        std::vector<std::thread> producers;
+        for (std::uint32_t p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&q, p] {
+                for (std::uint32_t i = 0; i < kPerProducer; ++i) {
+                    while (!q.post(static_cast<EventId>(p), i)) std::this_thread::yield();
+                }
+            });
+        }
+        std::uint32_t next[kProducers] = {};
+        bool ordered = true;
+        std::uint64_t received = 0;
+        while (received < std::uint64_t{kProducers} * kPerProducer) {
+            Event e;
+            if (!q.pop(e)) {
+                std::this_thread::yield();
+                continue;
+            }
+            ordered = ordered && e.id < kProducers && e.arg == next[e.id];
+            if (e.id < kProducers) ++next[e.id];
+            ++received;
+        }
+        for (auto& t : producers) t.join();
+        report(ordered && q.empty(), "queue: 4 producers, 1 consumer",
+               std::to_string(received) + " events, " + std::to_string(q.dropped()) + " full retries");
+    }
+
+    // The three firmwares must do the same work for the comparison to mean
+    // anything.
+    {
+        const Energy busy = run_sim(kBusyPoll);
+        const Energy wfi = run_sim(kPollWfi);
+        const Energy fsm = run_sim(kFsm);
+        const bool same = busy.samples == fsm.samples && wfi.samples == fsm.samples && busy.frames == fsm.frames &&
+                          wfi.frames == fsm.frames && busy.checksum == fsm.checksum && wfi.checksum == fsm.checksum;
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "%llu samples, %llu frames each",
+                      static_cast<unsigned long long>(fsm.samples), static_cast<unsigned long long>(fsm.frames));
+        report(same && fsm.samples > 0, "firmwares do the same work", buf);
+        std::snprintf(buf, sizeof(buf), "%.2f%% in Stop, %.1f uA average", fsm.stop, fsm.avg_ua);
+        report(fsm.stop > 95.0, "state machine idles in Stop", buf);
+    }
+    return ok ? 0 : 1;
+}
+
+}  // namespace
+
+int main() { return check(); }
@@ -0,0 +1,263 @@
+// A simulated sensor node on g7::sim, shared by the fsm test and
+// benchmarks. It samples every 100 ms, sends a frame every 10 samples and is
+// paused by a button for 10 s, for 60 s of virtual time, under one of three
+// firmwares:
+//   - the usual polling super-loop, which never sleeps;
+//   - the same loop ending in WFI, which can only use Sleep since it does
+//     not know whether the ADC or UART is busy;
+//   - the state machine, which sleeps as deep as its active state allows.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/fsm.hpp"
+#include "g7/sim/mcu.hpp"
+#include "g7/sim/peripherals.hpp"
+
+namespace g7::fsm::test {
+
+using g7::sim::Mcu;
+using g7::sim::Time;
+using g7::sim::ms;
+using g7::sim::us;
+
+inline constexpr Time kDuration = g7::sim::sec(60);
+inline constexpr Time kSamplePeriod = ms(100);
+inline constexpr Time kConversion = us(500);  // 16x oversampled reading
+inline constexpr Time kProcess = us(40);      // filter one reading
+inline constexpr Time kPack = us(60);         // build a frame
+inline constexpr Time kStopWakeup = us(5);    // clocks restart after Stop
+inline constexpr std::uint32_t kBatch = 10;
+inline constexpr std::size_t kFrameBytes = 12;
+inline constexpr Time kPauseAt = g7::sim::sec(20) + ms(50);  // between samples
+inline constexpr Time kResumeAt = g7::sim::sec(30) + ms(50);
+
+// Core current at 48 MHz, 3 V. Peripheral currents are the same for every
+// firmware and left out.
+inline constexpr double kRunUa = 4800;
+inline constexpr double kSleepUa = 1300;
+inline constexpr double kStopUa = 3;
+inline constexpr double kCr2032Uah = 225000;
+
+enum Mode { kBusyPoll, kPollWfi, kFsm };
+
+struct Board {
+    Mcu mcu{48000000};
+    g7::sim::Timer& lptim = mcu.add<g7::sim::Timer>("lptim1", 4);
+    g7::sim::Adc& adc = mcu.add<g7::sim::Adc>("adc1", 12, kConversion, 6);
+    g7::sim::Uart& uart = mcu.add<g7::sim::Uart>("usart1", 115200, 6);
+    g7::sim::Gpio& button = mcu.add<g7::sim::Gpio>("gpioa", 16, 8);
+
+    Time asleep[3] = {};  // by Power
+    std::uint64_t wakeups = 0;
+    std::uint64_t samples = 0;
+    std::uint64_t frames = 0;
+    std::uint32_t checksum = 0;
+
+    Board() {
+        adc.set_level(0, 2048);
+        adc.enable_irq(true);
+        uart.enable_tx_irq(true);
+        button.set_edge_irq(0, g7::sim::Edge::Falling);
+        for (Time t : {kPauseAt, kResumeAt}) {
+            mcu.schedule(t, [this] { button.drive(0, false); });
+            mcu.schedule(t + ms(50), [this] { button.drive(0, true); });
+        }
+        button.drive(0, true);
+        mcu.enable_irq(lptim.irq());
+        mcu.enable_irq(adc.irq());
+        mcu.enable_irq(uart.irq());
+        mcu.enable_irq(button.irq());
+    }
+
+    // Shared by every firmware so they do identical work.
+    void process(std::uint16_t reading) {
+        mcu.spend(kProcess);
+        checksum = checksum * 31 + reading;
+        ++samples;
+    }
+    void send_frame() {
+        mcu.spend(kPack);
+        for (std::size_t i = 0; i < kFrameBytes; ++i) uart.write(static_cast<std::uint8_t>(checksum >> (i % 4 * 8)));
+        ++frames;
+    }
+
+    // Low-power hook for run_once(); also used directly by the WFI loop.
+    void idle(Power mode) {
+        if (mode == Power::Run) {
+            mcu.spend_cycles(40);
+            return;
+        }
+        const Time before = mcu.sleep_time();
+        ++wakeups;
+        const bool woke = mcu.wfi(kDuration);
+        asleep[static_cast<int>(mode)] += mcu.sleep_time() - before;
+        if (woke && mode == Power::Stop) mcu.spend(kStopWakeup);
+    }
+    template <std::size_t N>
+    void sleep(Power mode, const EventQueue<N>& q) {
+        if (q.empty()) idle(mode);
+    }
+};
+
+// The firmware as a state chart.
+//
+//   Node
+//   +-- Running
+//   |   +-- Idle (Stop)
+//   |   +-- Active (Sleep: ADC or UART clocked)
+//   |       +-- Sampling
+//   |       +-- Sending
+//   +-- Paused (Stop)
+
+enum : StateId { kNode, kRunning, kIdle, kActive, kSampling, kSending, kPaused, kNodeStates };
+enum : EventId { kTick, kAdcDone, kTxDone, kButton, kNodeEvents };
+
+struct Node {
+    Board& board;
+    std::uint32_t batch = 0;
+};
+
+inline constexpr Chart<Node, kNodeStates, 7, kNodeEvents> kNodeChart{
+    kNode,
+    {{
+        {.name = "node", .initial = kRunning},
+        {.name = "running", .parent = kNode, .initial = kIdle},
+        {.name = "idle", .parent = kRunning},
+        {.name = "active", .parent = kRunning, .initial = kSampling, .deepest = Power::Sleep},
+        {.name = "sampling", .parent = kActive, .entry = [](Node& n) { n.board.adc.start(0); }},
+        {.name = "sending", .parent = kActive, .entry = [](Node& n) { n.board.send_frame(); }},
+        {.name = "paused", .parent = kNode},
+    }},
+    {{
+        {.from = kIdle, .event = kTick, .to = kSampling},
+        {.from = kSampling,
+         .event = kAdcDone,
+         .to = kSending,
+         .guard = [](const Node& n, const Event&) { return n.batch + 1 == kBatch; },
+         .action = [](Node& n, const Event& e) {
+             n.board.process(static_cast<std::uint16_t>(e.arg));
+             n.batch = 0;
+         }},
+        {.from = kSampling,
+         .event = kAdcDone,
+         .to = kIdle,
+         .action = [](Node& n, const Event& e) {
+             n.board.process(static_cast<std::uint16_t>(e.arg));
+             ++n.batch;
+         }},
+        {.from = kSending, .event = kTxDone, .to = kIdle},
+        {.from = kRunning, .event = kButton, .to = kPaused},
+        {.from = kPaused, .event = kButton, .to = kRunning},
+        // A tick while still busy is skipped, as in the super-loop.
+        {.from = kActive, .event = kTick},
+    }}};
+static_assert(kNodeChart.valid());
+
+inline void run_fsm(Board& b) {
+    EventQueue<16> q;
+    Node node{b};
+    Machine<kNodeChart> m(node);
+    b.mcu.set_handler(b.lptim.irq(), [&] { q.post(kTick); });
+    b.mcu.set_handler(b.adc.irq(), [&] { q.post(kAdcDone, b.adc.read()); });
+    b.mcu.set_handler(b.uart.irq(), [&] { q.post(kTxDone); });
+    b.mcu.set_handler(b.button.irq(), [&] {
+        b.button.take_pending();
+        q.post(kButton);
+    });
+    b.lptim.start(kSamplePeriod);
+    m.start();
+    while (b.mcu.now() < kDuration) run_once(m, q, b);
+}
+
+// The hand-written equivalent: interrupt flags polled by a switch.
+inline void run_superloop(Board& b, bool wfi) {
+    enum { Idle, Sampling, Sending } state = Idle;
+    volatile bool tick = false, adc_done = false, tx_done = false, button = false;
+    bool paused = false;
+    std::uint32_t batch = 0;
+    b.mcu.set_handler(b.lptim.irq(), [&] { tick = true; });
+    b.mcu.set_handler(b.adc.irq(), [&] { adc_done = true; });
+    b.mcu.set_handler(b.uart.irq(), [&] { tx_done = true; });
+    b.mcu.set_handler(b.button.irq(), [&] {
+        b.button.take_pending();
+        button = true;
+    });
+    b.lptim.start(kSamplePeriod);
+    while (b.mcu.now() < kDuration) {
+        if (button) {
+            button = false;
+            paused = !paused;
+            tick = false;
+        }
+        switch (state) {
+        case Idle:
+            if (tick) {
+                tick = false;
+                if (!paused) {
+                    b.adc.start(0);
+                    state = Sampling;
+                }
+            }
+            break;
+        case Sampling:
+            if (adc_done) {
+                adc_done = false;
+                b.process(b.adc.read());
+                if (++batch == kBatch) {
+                    batch = 0;
+                    b.send_frame();
+                    state = Sending;
+                } else {
+                    state = Idle;
+                }
+            }
+            break;
+        case Sending:
+            if (tx_done) {
+                tx_done = false;
+                state = Idle;
+            }
+            break;
+        }
+        if (wfi) {
+            b.idle(Power::Sleep);
+        } else {
+            b.mcu.spend_cycles(40);  // one pass of the polling loop
+        }
+    }
+}
+
+struct Energy {
+    double awake = 0, sleep = 0, stop = 0;  // % of virtual time
+    double avg_ua = 0;
+    double wakeups_per_s = 0;
+    std::uint64_t samples = 0, frames = 0;
+    std::uint32_t checksum = 0;
+};
+
+inline Energy run_sim(Mode mode) {
+    Board b;
+    if (mode == kFsm) {
+        run_fsm(b);
+    } else {
+        run_superloop(b, mode == kPollWfi);
+    }
+    const double total = static_cast<double>(b.mcu.now());
+    const double sleep = static_cast<double>(b.asleep[static_cast<int>(Power::Sleep)]);
+    const double stop = static_cast<double>(b.asleep[static_cast<int>(Power::Stop)]);
+    const double awake = total - sleep - stop;
+    Energy e;
+    e.awake = 100.0 * awake / total;
+    e.sleep = 100.0 * sleep / total;
+    e.stop = 100.0 * stop / total;
+    e.avg_ua = (awake * kRunUa + sleep * kSleepUa + stop * kStopUa) / total;
+    e.wakeups_per_s = static_cast<double>(b.wakeups) / (total / 1e9);
+    e.samples = b.samples;
+    e.frames = b.frames;
+    e.checksum = b.checksum;
+    return e;
+}
+
+}  // namespace g7::fsm::test
@@ -0,0 +1,353 @@
+// Scheduler benchmarks: context switch cost, timer wheel insert/expire cost
+// at 10k timers (against a sorted list), and wake-up jitter of a simulated
+// node run three ways on g7::sim: tick-less, 1 kHz ticked, and a busy-wait
+// super-loop.
+//
+//   ./g7_sched_bench --benchmark_counters_tabular=true
+//
+// Counters: ns/switch and ns/timer are host wall time. The simulated runs
+// report jitter percentiles (us of virtual time) of a 400 Hz sampling task,
+// wakeups/s and the share of virtual time the core spent asleep.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "g7/cycles.hpp"
+#include "g7/histogram.hpp"
+#include "g7/sched.hpp"
+#include "g7/sim/mcu.hpp"
+#include "g7/sim/peripherals.hpp"
+
+using namespace g7::sched;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Context switches
+
+constexpr int kYields = 10000;
+
+Task yielder(Scheduler& s, int n) {
+    for (int i = 0; i < n; ++i) co_await s.yield();
+}
+
+void BM_YieldSwitch(benchmark::State& state) {
+    ManualClock clock;
+    Scheduler s(clock);
+    for (auto _ : state) {
+        s.spawn(yielder(s, kYields));
+        s.spawn(yielder(s, kYields));
+        s.run();
+    }
+    const auto switches = static_cast<std::int64_t>(state.iterations()) * 2 * (kYields + 1);
+    state.SetItemsProcessed(switches);
+    state.counters["ns/switch"] =
+        benchmark::Counter(static_cast<double>(switches), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_YieldSwitch);
+
+Task ping(Event& mine, Event& other, int n) {
+    for (int i = 0; i < n; ++i) {
+        other.set();
+        co_await mine.wait();
+    }
+    other.set();
+}
+
+// Two tasks handing control back and forth through a pair of events.
+void BM_EventPingPong(benchmark::State& state) {
+    ManualClock clock;
+    Scheduler s(clock);
+    Event a(s), b(s);
+    for (auto _ : state) {
+        s.spawn(ping(a, b, kYields));
+        s.spawn(ping(b, a, kYields));
+        s.run();
+    }
+    const auto switches = static_cast<std::int64_t>(state.iterations()) * 2 * (kYields + 1);
+    state.SetItemsProcessed(switches);
+    state.counters["ns/switch"] =
+        benchmark::Counter(static_cast<double>(switches), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_EventPingPong);
+
+// ---------------------------------------------------------------------------
+// Timers
+
+std::vector<Tick> random_deadlines(std::size_t n, Tick horizon, std::uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<Tick> dist(1, horizon);
+    std::vector<Tick> v(n);
+    for (Tick& t : v) t = dist(rng);
+    return v;
+}
+
+void count_fire(TimerNode*) {}
+
+void set_ns_per_timer(benchmark::State& state, std::int64_t timers) {
+    state.SetItemsProcessed(timers);
+    state.counters["ns/timer"] =
+        benchmark::Counter(static_cast<double>(timers), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// range(0) timers spread over ~1 s at 1 us ticks, inserted then cancelled.
+void BM_WheelInsertCancel(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto when = random_deadlines(n, 1000000, 1);
+    std::vector<TimerNode> nodes(n);
+    TimerWheel wheel;
+    for (auto& t : nodes) t.fire = &count_fire;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) wheel.insert(nodes[i], when[i]);
+        for (auto& t : nodes) wheel.cancel(t);
+    }
+    set_ns_per_timer(state, static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_WheelInsertCancel)->Arg(1000)->Arg(10000);
+
+// Insert range(0) timers, then fire them all by advancing one tick-less jump
+// per expiry, as the scheduler does.
+void BM_WheelInsertExpire(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto when = random_deadlines(n, 1000000, 2);
+    std::vector<TimerNode> nodes(n);
+    for (auto& t : nodes) t.fire = &count_fire;
+    std::size_t fired = 0;
+    for (auto _ : state) {
+        TimerWheel wheel;
+        for (std::size_t i = 0; i < n; ++i) wheel.insert(nodes[i], when[i]);
+        for (Tick next = wheel.next_expiry(); next != kNever; next = wheel.next_expiry()) {
+            fired += wheel.advance(next);
+        }
+    }
+    benchmark::DoNotOptimize(fired);
+    set_ns_per_timer(state, static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_WheelInsertExpire)->Arg(1000)->Arg(10000);
+
+// Steady state: range(0) periodic timers (periods 100 us .. 100 ms) re-arm
+// themselves from their callbacks; each iteration advances to the next expiry.
+struct Periodic : TimerNode {
+    TimerWheel* wheel;
+    Tick period;
+};
+
+void rearm(TimerNode* n) {
+    auto* p = static_cast<Periodic*>(n);
+    p->wheel->insert(*p, p->expires + p->period);
+}
+
+void BM_WheelPeriodicChurn(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto periods = random_deadlines(n, 100000, 3);
+    TimerWheel wheel;
+    std::vector<Periodic> timers(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        timers[i].fire = &rearm;
+        timers[i].wheel = &wheel;
+        timers[i].period = 100 + periods[i];
+        wheel.insert(timers[i], timers[i].period);
+    }
+    std::int64_t fired = 0;
+    for (auto _ : state) {
+        fired += static_cast<std::int64_t>(wheel.advance(wheel.next_expiry()));
+    }
+    set_ns_per_timer(state, fired);
+}
+BENCHMARK(BM_WheelPeriodicChurn)->Arg(10000);
+
+// Baseline: a sorted intrusive list, the usual hand-rolled timer queue.
+struct ListTimer {
+    ListTimer* next = nullptr;
+    Tick expires = 0;
+};
+
+void BM_SortedListInsertExpire(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto when = random_deadlines(n, 1000000, 2);
+    std::vector<ListTimer> nodes(n);
+    std::size_t fired = 0;
+    for (auto _ : state) {
+        ListTimer* head = nullptr;
+        for (std::size_t i = 0; i < n; ++i) {
+            nodes[i].expires = when[i];
+            ListTimer** p = &head;
+            while (*p != nullptr && (*p)->expires <= when[i]) p = &(*p)->next;
+            nodes[i].next = *p;
+            *p = &nodes[i];
+        }
+        for (; head != nullptr; head = head->next) ++fired;
+    }
+    benchmark::DoNotOptimize(fired);
+    set_ns_per_timer(state, static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_SortedListInsertExpire)->Arg(1000)->Arg(10000);
+
+// ---------------------------------------------------------------------------
+// Wake-up jitter on the simulator
+
+using g7::sim::Mcu;
+using g7::sim::Time;
+using g7::sim::ms;
+using g7::sim::us;
+
+enum Mode { kTickless, kTicked, kSuperLoop };
+
+constexpr Time kTick = ms(1);
+constexpr Time kSamplePeriod = us(2500);
+constexpr Time kLogPeriod = ms(10);
+constexpr Time kRxPeriod = ms(7);
+
+// Scheduler clock on the simulated core: idling is Mcu::wfi(), so ISRs run
+// and sleep time is accounted by the simulator.
+class McuClock final : public Clock {
+public:
+    McuClock(Mcu& mcu, bool ticked) : mcu_(mcu), ticked_(ticked) {}
+    Tick now() const override { return mcu_.now(); }
+
+    bool idle_until(Tick deadline, const std::atomic<bool>& pending) override {
+        if (!ticked_) {
+            if (pending.load(std::memory_order_acquire)) return true;
+            ++wakeups;
+            return mcu_.wfi(deadline);
+        }
+        // A periodic tick wakes the core every kTick to check for due timers,
+        // so deadlines are only noticed on tick boundaries.
+        for (;;) {
+            if (pending.load(std::memory_order_acquire)) return true;
+            const Time next_tick = (mcu_.now() / kTick + 1) * kTick;
+            ++wakeups;
+            if (mcu_.wfi(next_tick)) return true;
+            mcu_.spend_cycles(150);  // SysTick handler
+            if (next_tick >= deadline) return false;
+        }
+    }
+
+    std::uint64_t wakeups = 0;
+
+private:
+    Mcu& mcu_;
+    bool ticked_;
+};
+
+struct Node {
+    Mcu& mcu;
+    g7::Histogram jitter;
+    std::uint64_t rx = 0;
+};
+
+Task sampler(Scheduler& s, Node& n) {
+    Time next = kSamplePeriod;
+    for (;;) {
+        co_await s.sleep_until(next);
+        n.jitter.add(s.now() - next);
+        n.mcu.spend(us(20));
+        next += kSamplePeriod;
+    }
+}
+
+// Long job split into two cooperative chunks.
+Task logger(Scheduler& s, Node& n) {
+    for (;;) {
+        co_await s.sleep_for(kLogPeriod);
+        n.mcu.spend(us(150));
+        co_await s.yield();
+        n.mcu.spend(us(150));
+    }
+}
+
+Task comms(Event& rx, Node& n) {
+    for (;;) {
+        co_await rx.wait();
+        ++n.rx;
+        n.mcu.spend(us(15));
+    }
+}
+
+struct SimResult {
+    g7::Histogram jitter;
+    double asleep = 0;
+    double wakeups_per_s = 0;
+    std::uint64_t rx = 0;
+};
+
+SimResult run_sim(Mode mode, Time duration) {
+    Mcu mcu(48000000);
+    auto& tim = mcu.add<g7::sim::Timer>("tim2");
+    Node node{mcu, {}, 0};
+    SimResult r;
+
+    if (mode == kSuperLoop) {
+        // The default firmware shape: poll everything, never sleep.
+        volatile bool rx_flag = false;
+        mcu.set_handler(tim.irq(), [&] { rx_flag = true; });
+        mcu.enable_irq(tim.irq());
+        tim.start(kRxPeriod);
+        Time next_sample = kSamplePeriod;
+        Time next_log = kLogPeriod;
+        while (mcu.now() < duration) {
+            if (mcu.now() >= next_sample) {
+                node.jitter.add(mcu.now() - next_sample);
+                mcu.spend(us(20));
+                next_sample += kSamplePeriod;
+            }
+            if (mcu.now() >= next_log) {
+                mcu.spend(us(300));
+                next_log = mcu.now() + kLogPeriod;
+            }
+            if (rx_flag) {
+                rx_flag = false;
+                ++node.rx;
+                mcu.spend(us(15));
+            }
+            mcu.spend_cycles(40);  // one pass of the polling loop
+        }
+        r.wakeups_per_s = 0;
+    } else {
+        McuClock clock(mcu, mode == kTicked);
+        Scheduler s(clock);
+        Event rx(s);
+        mcu.set_handler(tim.irq(), [&] { rx.set_from_isr(); });
+        mcu.enable_irq(tim.irq());
+        tim.start(kRxPeriod);
+        s.spawn(sampler(s, node));
+        s.spawn(logger(s, node));
+        s.spawn(comms(rx, node));
+        s.run_until(duration);
+        r.wakeups_per_s = static_cast<double>(clock.wakeups) / (static_cast<double>(mcu.now()) / 1e9);
+    }
+    r.jitter = node.jitter;
+    r.asleep = 100.0 * static_cast<double>(mcu.sleep_time()) / static_cast<double>(mcu.now());
+    r.rx = node.rx;
+    return r;
+}
+
+// range(0) is the Mode; 10 s of virtual time per iteration.
+void BM_SimJitter(benchmark::State& state) {
+    const auto mode = static_cast<Mode>(state.range(0));
+    SimResult r;
+    for (auto _ : state) {
+        r = run_sim(mode, g7::sim::sec(10));
+    }
+    state.SetLabel(mode == kTickless ? "tick-less" : mode == kTicked ? "1 kHz tick" : "super-loop");
+    state.counters["jitter_p50_us"] = static_cast<double>(r.jitter.percentile(50)) / 1e3;
+    state.counters["jitter_p99_us"] = static_cast<double>(r.jitter.percentile(99)) / 1e3;
+    state.counters["jitter_max_us"] = static_cast<double>(r.jitter.max()) / 1e3;
+    state.counters["asleep%"] = r.asleep;
+    state.counters["wakeups/s"] = r.wakeups_per_s;
+    state.counters["rx_events"] = static_cast<double>(r.rx);
+    state.counters["frame_B"] = static_cast<double>(frame_high_water());
+}
+BENCHMARK(BM_SimJitter)
+    ->Arg(kTickless)
+    ->Arg(kTicked)
+    ->Arg(kSuperLoop)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(1);
+
+}  // namespace
+
+BENCHMARK_MAIN();
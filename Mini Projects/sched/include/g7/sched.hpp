@@ -0,0 +1,6 @@
+// Umbrella header for the cooperative scheduler.
+#pragma once
+
+#include "g7/sched/scheduler.hpp"
+#include "g7/sched/task.hpp"
+#include "g7/sched/timer_wheel.hpp"
@@ -0,0 +1,219 @@
+// Allocation-free cooperative scheduler for single-core nodes.
+//
+// Tasks are C++20 coroutines (see task.hpp) that suspend on one of three
+// awaitables:
+//
+//   co_await sched.sleep_for(ticks);     // or sleep_until(t)
+//   co_await sched.yield();              // back of the ready queue
+//   bool ok = co_await event.wait_for(ticks);  // false on timeout
+//
+// Sleeping tasks are parked in a hierarchical timer wheel. When nothing is
+// ready, the scheduler asks its Clock to idle until the next timer expiry
+// or an interrupt. There is no periodic tick: a node with one task blinking
+// at 1 Hz wakes once a second, not a thousand times.
+//
+// Interrupt handlers talk to tasks only through Event::set_from_isr(), which
+// is two atomic stores; the scheduler picks the event up before it next
+// idles. Everything else is task-context only.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "g7/sched/task.hpp"
+#include "g7/sched/timer_wheel.hpp"
+
+namespace g7::sched {
+
+// Time source and low-power idle hook. Tick units are the clock's own.
+class Clock {
+public:
+    virtual ~Clock() = default;
+    virtual Tick now() const = 0;
+    // Idles until `deadline` (kNever when no timer is armed) or an interrupt.
+    // Must return immediately if `pending` is set. On target, test it with
+    // interrupts masked and then WFI, so an event raised after the
+    // scheduler's last check still wakes the core. Returns false if nothing
+    // can wake the core before the deadline.
+    virtual bool idle_until(Tick deadline, const std::atomic<bool>& pending) = 0;
+};
+
+// Clock that only moves when told to; idling jumps straight to the deadline.
+class ManualClock final : public Clock {
+public:
+    explicit ManualClock(Tick start = 0) : now_(start) {}
+    Tick now() const override { return now_; }
+    bool idle_until(Tick deadline, const std::atomic<bool>& pending) override {
+        if (pending.load(std::memory_order_acquire)) return true;
+        if (deadline != kNever && deadline > now_) now_ = deadline;
+        return false;
+    }
+    // Stands in for CPU time spent by a task.
+    void advance(Tick d) { now_ += d; }
+
+private:
+    Tick now_;
+};
+
+struct SchedStats {
+    std::uint64_t switches = 0;      // task resumptions
+    std::uint64_t idle_entries = 0;  // calls to Clock::idle_until
+    Tick idle_ticks = 0;             // clock time spent idle
+    std::uint64_t timer_wakeups = 0;
+    std::uint64_t isr_events = 0;    // Event::set_from_isr calls picked up
+};
+
+class Event;
+
+class Scheduler {
+public:
+    class SleepAwaiter;
+    class YieldAwaiter;
+
+    explicit Scheduler(Clock& clock);
+    // Destroys the frames of tasks that are still alive.
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // Queues a task. False if `t` is empty (its frame could not be allocated).
+    bool spawn(Task t);
+
+    // Runs until no task is alive, or every task is blocked on an Event and
+    // the clock reports that nothing can wake the core.
+    void run() { run_until(kNever); }
+    // As run(), but also returns once the clock reaches `limit`.
+    void run_until(Tick limit);
+
+    Tick now() const { return clock_.now(); }
+    Clock& clock() { return clock_; }
+    std::size_t tasks() const { return live_; }
+    std::size_t timers() const { return wheel_.size(); }
+    const SchedStats& stats() const { return stats_; }
+
+    SleepAwaiter sleep_until(Tick t);
+    SleepAwaiter sleep_for(Tick d);
+    YieldAwaiter yield();
+
+    class SleepAwaiter : private TimerNode {
+    public:
+        SleepAwaiter(const SleepAwaiter&) = delete;
+        SleepAwaiter& operator=(const SleepAwaiter&) = delete;
+        ~SleepAwaiter() { s_.wheel_.cancel(*this); }
+
+        bool await_ready() const { return deadline_ <= s_.now(); }
+        void await_suspend(Task::Handle h) {
+            h_ = h;
+            fire = &on_fire;
+            s_.wheel_.insert(*this, deadline_);
+        }
+        void await_resume() const {}
+
+    private:
+        friend class Scheduler;
+        SleepAwaiter(Scheduler& s, Tick deadline) : s_(s), deadline_(deadline) {}
+        static void on_fire(TimerNode* n) {
+            auto* a = static_cast<SleepAwaiter*>(n);
+            ++a->s_.stats_.timer_wakeups;
+            a->s_.make_ready(a->h_);
+        }
+
+        Scheduler& s_;
+        Tick deadline_;
+        Task::Handle h_{};
+    };
+
+    class YieldAwaiter {
+    public:
+        bool await_ready() const { return false; }
+        void await_suspend(Task::Handle h) { s_.make_ready(h); }
+        void await_resume() const {}
+
+    private:
+        friend class Scheduler;
+        explicit YieldAwaiter(Scheduler& s) : s_(s) {}
+        Scheduler& s_;
+    };
+
+private:
+    friend class Event;
+    using Promise = Task::promise_type;
+
+    void make_ready(Task::Handle h);
+    void poll_events();
+    void run_ready();
+
+    Clock& clock_;
+    TimerWheel wheel_;
+    SchedStats stats_;
+    Promise* head_ = nullptr;
+    Promise* tail_ = nullptr;
+    std::size_t ready_ = 0;
+    std::size_t live_ = 0;
+    Task::Handle tasks_[kMaxTasks] = {};
+    Event* events_ = nullptr;
+    std::atomic<bool> pending_{false};
+};
+
+// Auto-reset event. set() wakes every waiting task, or latches if none is
+// waiting so the next wait completes at once. Destroying an Event resumes its
+// waiters with false.
+class Event {
+public:
+    class Awaiter;
+
+    explicit Event(Scheduler& s);
+    ~Event();
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
+
+    Awaiter wait();
+    // co_await yields false if `timeout` ticks pass first.
+    Awaiter wait_for(Tick timeout);
+
+    // Task context.
+    void set();
+    // Interrupt context: lock-free, safe from nested handlers.
+    void set_from_isr() {
+        isr_pending_.store(true, std::memory_order_release);
+        s_.pending_.store(true, std::memory_order_release);
+    }
+
+    class Awaiter : private TimerNode {
+    public:
+        Awaiter(const Awaiter&) = delete;
+        Awaiter& operator=(const Awaiter&) = delete;
+        ~Awaiter();
+
+        bool await_ready();
+        void await_suspend(Task::Handle h);
+        bool await_resume() const { return signalled_; }
+
+    private:
+        friend class Event;
+        Awaiter(Event& e, Tick deadline) : s_(e.s_), e_(&e), deadline_(deadline) {}
+        static void on_timeout(TimerNode* n);
+        void wake(bool signalled);
+
+        Scheduler& s_;
+        Event* e_;
+        Tick deadline_;
+        Task::Handle h_{};
+        Awaiter* next_ = nullptr;
+        bool queued_ = false;
+        bool signalled_ = false;
+    };
+
+private:
+    friend class Scheduler;
+    void unlink(Awaiter& a);
+
+    Scheduler& s_;
+    Event* next_ = nullptr;  // scheduler's event list
+    Awaiter* waiters_ = nullptr;
+    bool latched_ = false;
+    std::atomic<bool> isr_pending_{false};
+};
+
+}  // namespace g7::sched
@@ -0,0 +1,103 @@
+// Coroutine task type for the cooperative scheduler.
+//
+//   g7::sched::Task blink(g7::sched::Scheduler& s) {
+//       for (;;) {
+//           led_toggle();
+//           co_await s.sleep_for(500'000);
+//       }
+//   }
+//   sched.spawn(blink(sched));
+//
+// Coroutine frames come from a static pool of G7_SCHED_MAX_TASKS slots of
+// G7_SCHED_FRAME_SIZE bytes each, never from the heap. A frame that is too
+// large, or a full pool, makes the coroutine call return an empty Task, and
+// spawn() then refuses it. frame_high_water() reports the largest frame
+// requested, which is what G7_SCHED_FRAME_SIZE should be sized to; frame
+// sizes depend on the compiler and optimisation level. Define both macros for
+// the whole build.
+//
+// Tasks are flat: a task suspends only on the scheduler's awaitables
+// (sleep, yield, Event) and cannot co_await another Task.
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+
+#if !defined(G7_SCHED_FRAME_SIZE)
+#define G7_SCHED_FRAME_SIZE 256
+#endif
+#if !defined(G7_SCHED_MAX_TASKS)
+#define G7_SCHED_MAX_TASKS 16
+#endif
+
+namespace g7::sched {
+
+class Scheduler;
+
+inline constexpr std::size_t kFrameSize = G7_SCHED_FRAME_SIZE;
+inline constexpr std::size_t kMaxTasks = G7_SCHED_MAX_TASKS;
+
+// Frame pool statistics.
+std::size_t frames_in_use();
+std::size_t frame_high_water();
+// Coroutine calls that got an empty Task because the frame was too large or
+// the pool was full.
+std::size_t frame_failures();
+
+namespace detail {
+void* frame_alloc(std::size_t n) noexcept;
+void frame_free(void* p) noexcept;
+}  // namespace detail
+
+class Task {
+public:
+    struct promise_type {
+        Scheduler* sched = nullptr;
+        promise_type* next = nullptr;  // ready-queue link
+
+        static void* operator new(std::size_t n) noexcept { return detail::frame_alloc(n); }
+        static void operator delete(void* p) noexcept { detail::frame_free(p); }
+        static Task get_return_object_on_allocation_failure() noexcept { return Task{}; }
+
+        Task get_return_object() noexcept {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        // Tasks start suspended; spawn() queues them.
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        // The scheduler destroys finished frames after resume() returns.
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        // Firmware builds run without exceptions; treat one as fatal on the host.
+        void unhandled_exception() noexcept { std::abort(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task(Task&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+    Task& operator=(Task&& o) noexcept {
+        if (this != &o) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(o.h_, {});
+        }
+        return *this;
+    }
+    // A Task that was never spawned still owns its frame.
+    ~Task() {
+        if (h_) h_.destroy();
+    }
+
+    explicit operator bool() const { return static_cast<bool>(h_); }
+
+    // Hands the frame over to the scheduler.
+    Handle release() { return std::exchange(h_, {}); }
+
+private:
+    explicit Task(Handle h) : h_(h) {}
+    Handle h_{};
+};
+
+}  // namespace g7::sched
@@ -0,0 +1,95 @@
+// Hierarchical timer wheel.
+//
+// Six levels of 64 slots. A timer sits at the level of the highest 6-bit
+// group in which its expiry differs from the wheel's current time, so level 0
+// holds the next 64 ticks at one-tick resolution, level 1 the next 4096 ticks
+// at 64-tick resolution, and so on up to 2^36 ticks. Timers further out wait
+// in an overflow list. Insert and cancel are O(1); advance() touches only
+// occupied slots (found with a per-level bitmap), cascading each timer down
+// at most once per level, so jumping the clock forward by an arbitrary
+// amount after a tick-less sleep costs nothing for the empty time in between.
+//
+// Nodes are intrusive: the caller owns the TimerNode storage and the wheel
+// never allocates. Not thread-safe; drive it from one context.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace g7::sched {
+
+using Tick = std::uint64_t;
+inline constexpr Tick kNever = ~Tick{0};
+
+struct TimerNode {
+    // Called from TimerWheel::advance() once the timer is due.
+    void (*fire)(TimerNode*) = nullptr;
+    Tick expires = 0;
+
+    bool armed() const { return level_ != kIdle; }
+
+private:
+    friend class TimerWheel;
+    static constexpr std::uint8_t kIdle = 0xff;
+
+    TimerNode* next_ = nullptr;
+    TimerNode* prev_ = nullptr;
+    std::uint8_t level_ = kIdle;
+    std::uint8_t slot_ = 0;
+};
+
+class TimerWheel {
+public:
+    static constexpr int kLevelBits = 6;
+    static constexpr int kSlots = 1 << kLevelBits;
+    static constexpr int kLevels = 6;
+    static constexpr Tick kSpan = Tick{1} << (kLevelBits * kLevels);
+
+    explicit TimerWheel(Tick now = 0) : now_(now) {}
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    Tick now() const { return now_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Arms `t` to fire at `expires` (re-arming it if already armed). A time at
+    // or before now() fires on the next advance().
+    void insert(TimerNode& t, Tick expires);
+    // Disarms `t`; harmless if it is not armed.
+    void cancel(TimerNode& t);
+
+    // Moves the wheel to `to`, firing every timer with expires <= to in
+    // expiry order. Callbacks may insert or cancel timers, including the
+    // one firing. Returns the number fired.
+    std::size_t advance(Tick to);
+
+    // Earliest armed expiry, or kNever. This is the deadline a tick-less idle
+    // loop should program into its wake-up timer.
+    Tick next_expiry() const;
+
+private:
+    static constexpr std::uint8_t kDue = kLevels;
+    static constexpr std::uint8_t kOverflow = kLevels + 1;
+    // Detached by advance() and about to fire; kept linked so a callback can
+    // still cancel or re-arm the rest of its batch.
+    static constexpr std::uint8_t kFiring = kLevels + 2;
+
+    void place(TimerNode& t);
+    void link(TimerNode*& head, TimerNode& t);
+    void unlink(TimerNode*& head, TimerNode& t);
+    TimerNode*& head_of(const TimerNode& t);
+    std::size_t fire_list(TimerNode* list);
+    void rehome_overflow();
+    static Tick min_expiry(const TimerNode* list);
+
+    Tick now_;
+    std::size_t size_ = 0;
+    std::uint64_t occupied_[kLevels] = {};
+    TimerNode* slots_[kLevels][kSlots] = {};
+    TimerNode* due_ = nullptr;
+    TimerNode* overflow_ = nullptr;
+    TimerNode* firing_ = nullptr;
+};
+
+}  // namespace g7::sched
@@ -0,0 +1,229 @@
+#include "g7/sched/scheduler.hpp"
+
+#include "g7/block_pool.hpp"
+
+namespace g7::sched {
+
+// ---------------------------------------------------------------------------
+// Frame pool
+
+namespace {
+
+g7::BlockPool<kFrameSize, kMaxTasks> g_frames;
+std::size_t g_high_water = 0;
+std::size_t g_failures = 0;
+
+}  // namespace
+
+std::size_t frames_in_use() { return kMaxTasks - g_frames.available(); }
+std::size_t frame_high_water() { return g_high_water; }
+std::size_t frame_failures() { return g_failures; }
+
+namespace detail {
+
+void* frame_alloc(std::size_t n) noexcept {
+    if (n > g_high_water) g_high_water = n;
+    void* p = n <= kFrameSize ? g_frames.allocate() : nullptr;
+    if (p == nullptr) ++g_failures;
+    return p;
+}
+
+void frame_free(void* p) noexcept { g_frames.release(p); }
+
+}  // namespace detail
+
+// ---------------------------------------------------------------------------
+// Scheduler
+
+Scheduler::Scheduler(Clock& clock) : clock_(clock), wheel_(clock.now()) {}
+
+Scheduler::~Scheduler() {
+    // Destroying a suspended frame runs its awaiter destructors, which
+    // disarm timers and leave event wait lists.
+    for (Task::Handle& h : tasks_) {
+        if (h) h.destroy();
+        h = {};
+    }
+}
+
+bool Scheduler::spawn(Task t) {
+    if (!t) return false;
+    Task::Handle h = t.release();
+    for (Task::Handle& slot : tasks_) {
+        if (!slot) {
+            slot = h;
+            h.promise().sched = this;
+            ++live_;
+            make_ready(h);
+            return true;
+        }
+    }
+    // Unreachable while the frame pool and the task table share kMaxTasks.
+    h.destroy();
+    return false;
+}
+
+Scheduler::SleepAwaiter Scheduler::sleep_until(Tick t) { return SleepAwaiter(*this, t); }
+
+Scheduler::SleepAwaiter Scheduler::sleep_for(Tick d) { return SleepAwaiter(*this, clock_.now() + d); }
+
+Scheduler::YieldAwaiter Scheduler::yield() { return YieldAwaiter(*this); }
+
+void Scheduler::make_ready(Task::Handle h) {
+    Promise& p = h.promise();
+    p.next = nullptr;
+    if (tail_ != nullptr) {
+        tail_->next = &p;
+    } else {
+        head_ = &p;
+    }
+    tail_ = &p;
+    ++ready_;
+}
+
+void Scheduler::poll_events() {
+    if (!pending_.exchange(false, std::memory_order_acq_rel)) return;
+    for (Event* e = events_; e != nullptr; e = e->next_) {
+        if (e->isr_pending_.exchange(false, std::memory_order_acq_rel)) {
+            ++stats_.isr_events;
+            e->set();
+        }
+    }
+}
+
+// Resumes each task that was ready on entry once; tasks made ready meanwhile
+// wait for the next round so timers and events are polled between rounds.
+void Scheduler::run_ready() {
+    for (std::size_t n = ready_; n > 0 && head_ != nullptr; --n) {
+        Promise* p = head_;
+        head_ = p->next;
+        if (head_ == nullptr) tail_ = nullptr;
+        --ready_;
+        auto h = Task::Handle::from_promise(*p);
+        ++stats_.switches;
+        h.resume();
+        if (h.done()) {
+            for (Task::Handle& slot : tasks_) {
+                if (slot == h) slot = {};
+            }
+            h.destroy();
+            --live_;
+        }
+    }
+}
+
+void Scheduler::run_until(Tick limit) {
+    for (;;) {
+        poll_events();
+        wheel_.advance(clock_.now());
+        if (ready_ > 0) {
+            run_ready();
+            continue;
+        }
+        if (live_ == 0) return;
+        const Tick now = clock_.now();
+        if (now >= limit) return;
+
+        // Tick-less idle: sleep straight through to the next timer.
+        const Tick next = wheel_.next_expiry();
+        const Tick deadline = next < limit ? next : limit;
+        ++stats_.idle_entries;
+        const bool woken = clock_.idle_until(deadline, pending_);
+        stats_.idle_ticks += clock_.now() - now;
+        if (!woken && deadline == kNever) return;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Event
+
+Event::Event(Scheduler& s) : s_(s), next_(s.events_) { s.events_ = this; }
+
+Event::~Event() {
+    for (Event** e = &s_.events_; *e != nullptr; e = &(*e)->next_) {
+        if (*e == this) {
+            *e = next_;
+            break;
+        }
+    }
+    // Wake waiters as if they timed out, disarming their timers so that none
+    // is left pointing at this event.
+    Awaiter* a = waiters_;
+    waiters_ = nullptr;
+    while (a != nullptr) {
+        Awaiter* next = a->next_;
+        a->queued_ = false;
+        a->wake(false);
+        a = next;
+    }
+}
+
+Event::Awaiter Event::wait() { return Awaiter(*this, kNever); }
+
+Event::Awaiter Event::wait_for(Tick timeout) { return Awaiter(*this, s_.now() + timeout); }
+
+void Event::set() {
+    if (waiters_ == nullptr) {
+        latched_ = true;
+        return;
+    }
+    Awaiter* a = waiters_;
+    waiters_ = nullptr;
+    while (a != nullptr) {
+        Awaiter* next = a->next_;
+        a->queued_ = false;
+        a->wake(true);
+        a = next;
+    }
+}
+
+void Event::unlink(Awaiter& a) {
+    for (Awaiter** p = &waiters_; *p != nullptr; p = &(*p)->next_) {
+        if (*p == &a) {
+            *p = a.next_;
+            break;
+        }
+    }
+    a.queued_ = false;
+}
+
+Event::Awaiter::~Awaiter() {
+    if (queued_) e_->unlink(*this);
+    s_.wheel_.cancel(*this);
+}
+
+bool Event::Awaiter::await_ready() {
+    if (e_->latched_) {
+        e_->latched_ = false;
+        signalled_ = true;
+        return true;
+    }
+    // An already expired timeout completes without suspending.
+    return deadline_ <= s_.now();
+}
+
+void Event::Awaiter::await_suspend(Task::Handle h) {
+    h_ = h;
+    next_ = e_->waiters_;
+    e_->waiters_ = this;
+    queued_ = true;
+    if (deadline_ != kNever) {
+        fire = &on_timeout;
+        s_.wheel_.insert(*this, deadline_);
+    }
+}
+
+void Event::Awaiter::on_timeout(TimerNode* n) {
+    auto* a = static_cast<Awaiter*>(n);
+    a->e_->unlink(*a);
+    ++a->s_.stats_.timer_wakeups;
+    a->wake(false);
+}
+
+void Event::Awaiter::wake(bool signalled) {
+    signalled_ = signalled;
+    s_.wheel_.cancel(*this);
+    s_.make_ready(h_);
+}
+
+}  // namespace g7::sched
@@ -0,0 +1,197 @@
+#include "g7/sched/timer_wheel.hpp"
+
+#include <bit>
+
+namespace g7::sched {
+
+// ---------------------------------------------------------------------------
+// Lists
+
+TimerNode*& TimerWheel::head_of(const TimerNode& t) {
+    if (t.level_ == kDue) return due_;
+    if (t.level_ == kOverflow) return overflow_;
+    if (t.level_ == kFiring) return firing_;
+    return slots_[t.level_][t.slot_];
+}
+
+void TimerWheel::link(TimerNode*& head, TimerNode& t) {
+    t.prev_ = nullptr;
+    t.next_ = head;
+    if (head != nullptr) head->prev_ = &t;
+    head = &t;
+}
+
+void TimerWheel::unlink(TimerNode*& head, TimerNode& t) {
+    if (t.prev_ != nullptr) {
+        t.prev_->next_ = t.next_;
+    } else {
+        head = t.next_;
+    }
+    if (t.next_ != nullptr) t.next_->prev_ = t.prev_;
+    if (t.level_ < kLevels && head == nullptr) {
+        occupied_[t.level_] &= ~(std::uint64_t{1} << t.slot_);
+    }
+    t.next_ = t.prev_ = nullptr;
+}
+
+// Files `t` under the level of the highest 6-bit group where its expiry and
+// now_ differ. Every timer at level L therefore shares all bits above L with
+// now_ and sits in a slot after now_'s own slot at that level.
+void TimerWheel::place(TimerNode& t) {
+    if (t.expires <= now_) {
+        t.level_ = kDue;
+        link(due_, t);
+        return;
+    }
+    const int level = (63 - std::countl_zero(t.expires ^ now_)) / kLevelBits;
+    if (level >= kLevels) {
+        t.level_ = kOverflow;
+        link(overflow_, t);
+        return;
+    }
+    const auto slot = static_cast<std::uint8_t>((t.expires >> (level * kLevelBits)) & (kSlots - 1));
+    t.level_ = static_cast<std::uint8_t>(level);
+    t.slot_ = slot;
+    link(slots_[level][slot], t);
+    occupied_[level] |= std::uint64_t{1} << slot;
+}
+
+Tick TimerWheel::min_expiry(const TimerNode* list) {
+    Tick m = kNever;
+    for (; list != nullptr; list = list->next_) {
+        if (list->expires < m) m = list->expires;
+    }
+    return m;
+}
+
+// ---------------------------------------------------------------------------
+// Public interface
+
+void TimerWheel::insert(TimerNode& t, Tick expires) {
+    if (t.armed()) {
+        unlink(head_of(t), t);
+    } else {
+        ++size_;
+    }
+    t.expires = expires;
+    place(t);
+}
+
+void TimerWheel::cancel(TimerNode& t) {
+    if (!t.armed()) return;
+    unlink(head_of(t), t);
+    t.level_ = TimerNode::kIdle;
+    --size_;
+}
+
+std::size_t TimerWheel::fire_list(TimerNode* list) {
+    // Park the batch on firing_, in order, so that a callback cancelling or
+    // re-arming a later member unlinks it from there instead of from the
+    // list it was detached from.
+    TimerNode* tail = nullptr;
+    while (list != nullptr) {
+        TimerNode* t = list;
+        list = t->next_;
+        t->level_ = kFiring;
+        t->prev_ = tail;
+        t->next_ = nullptr;
+        if (tail != nullptr) {
+            tail->next_ = t;
+        } else {
+            firing_ = t;
+        }
+        tail = t;
+    }
+    std::size_t n = 0;
+    while (firing_ != nullptr) {
+        TimerNode* t = firing_;
+        unlink(firing_, *t);
+        t->level_ = TimerNode::kIdle;
+        --size_;
+        ++n;
+        t->fire(t);
+    }
+    return n;
+}
+
+void TimerWheel::rehome_overflow() {
+    TimerNode* list = overflow_;
+    overflow_ = nullptr;
+    while (list != nullptr) {
+        TimerNode* t = list;
+        list = t->next_;
+        place(*t);
+    }
+}
+
+std::size_t TimerWheel::advance(Tick to) {
+    if (to < now_) to = now_;
+    TimerNode* due = due_;
+    due_ = nullptr;
+    std::size_t fired = fire_list(due);
+
+    for (;;) {
+        int level = 0;
+        while (level < kLevels && occupied_[level] == 0) ++level;
+        if (level == kLevels) {
+            // Wheel empty: jump straight to the first overflow timer if it
+            // falls inside this advance.
+            const Tick first = min_expiry(overflow_);
+            if (first == kNever || first > to) break;
+            now_ = first;
+            rehome_overflow();
+            due = due_;
+            due_ = nullptr;
+            fired += fire_list(due);
+            continue;
+        }
+        // The lowest occupied level holds the earliest slot, and its first
+        // occupied bit is the next slot in time.
+        const int shift = level * kLevelBits;
+        const int slot = std::countr_zero(occupied_[level]);
+        const Tick range = (Tick{1} << (shift + kLevelBits)) - 1;
+        const Tick start = (now_ & ~range) | (static_cast<Tick>(slot) << shift);
+        if (start > to) break;
+        now_ = start;
+
+        TimerNode* list = slots_[level][slot];
+        slots_[level][slot] = nullptr;
+        occupied_[level] &= ~(std::uint64_t{1} << slot);
+        // Timers due at the slot start fire; the rest cascade to a lower level.
+        TimerNode* ready = nullptr;
+        while (list != nullptr) {
+            TimerNode* t = list;
+            list = t->next_;
+            if (t->expires <= now_) {
+                t->next_ = ready;
+                ready = t;
+            } else {
+                place(*t);
+            }
+        }
+        fired += fire_list(ready);
+    }
+
+    // Nothing left at or before `to`, so every armed slot starts after it and
+    // moving now_ there keeps the placement invariant.
+    now_ = to;
+    rehome_overflow();
+    return fired;
+}
+
+Tick TimerWheel::next_expiry() const {
+    if (due_ != nullptr || firing_ != nullptr) return now_;
+    for (int level = 0; level < kLevels; ++level) {
+        if (occupied_[level] == 0) continue;
+        const int slot = std::countr_zero(occupied_[level]);
+        if (level == 0) {
+            return (now_ & ~Tick{kSlots - 1}) | static_cast<Tick>(slot);
+        }
+        // Everything in a higher-level slot expires before the next slot
+        // starts, so the earliest timer is the minimum of this one list.
+        return min_expiry(slots_[level][slot]);
+    }
+    return min_expiry(overflow_);
+}
+
+}  // namespace g7::sched
@@ -0,0 +1,254 @@
+// Scheduler checks: timer wheel expiry order and next_expiry() against a
+// sorted reference, cancel and re-arm from inside callbacks, Event::wait_for
+// timeouts, waiters of a destroyed Event, and the run_until() limit.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "g7/sched.hpp"
+
+using namespace g7::sched;
+
+namespace {
+
+bool g_ok = true;
+
+void report(bool pass, const char* what, const std::string& detail) {
+    std::printf("%s %-34s %s\n", pass ? "ok      " : "MISMATCH", what, detail.c_str());
+    g_ok = g_ok && pass;
+}
+
+// A timer that logs the wheel time it fired at.
+struct Probe : TimerNode {
+    TimerWheel* wheel = nullptr;
+    std::vector<Tick>* log = nullptr;
+    // Optional extra work, run after logging.
+    void (*then)(Probe&) = nullptr;
+    Probe* other = nullptr;
+    int count = 0;
+
+    void attach(TimerWheel& w, std::vector<Tick>& l) {
+        wheel = &w;
+        log = &l;
+        fire = [](TimerNode* n) {
+            auto& p = *static_cast<Probe*>(n);
+            p.log->push_back(p.wheel->now());
+            ++p.count;
+            if (p.then != nullptr) p.then(p);
+        };
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Timer wheel
+
+// Random expiries across every level, the overflow list and the past, fired
+// by random advances: each timer must fire exactly once, at its own expiry,
+// in expiry order, and next_expiry() must always name the next one.
+void wheel_order() {
+    constexpr std::size_t kTimers = 20000;
+    constexpr Tick kStart = 1000;
+    std::mt19937_64 rng(5);
+    TimerWheel w(kStart);
+    std::vector<Tick> fired;
+    std::vector<Probe> probes(kTimers);
+    std::vector<Tick> want;
+    for (Probe& p : probes) {
+        p.attach(w, fired);
+        Tick e = 0;
+        switch (rng() % 5) {
+        case 0: e = kStart - rng() % kStart; break;                 // already due
+        case 1: e = kStart + rng() % 64; break;                     // level 0
+        case 2: e = kStart + rng() % (Tick{1} << 18); break;        // low levels
+        case 3: e = kStart + rng() % TimerWheel::kSpan; break;      // any level
+        default: e = kStart + rng() % (TimerWheel::kSpan * 8); break;  // overflow
+        }
+        w.insert(p, e);
+        want.push_back(std::max(e, kStart));
+    }
+    std::sort(want.begin(), want.end());
+
+    bool next_ok = true;
+    std::size_t advances = 0;
+    while (!w.empty()) {
+        const Tick next = w.next_expiry();
+        next_ok = next_ok && next == want[fired.size()];
+        const Tick step = rng() % 2 ? rng() % 64 : rng() % (Tick{1} << 34);
+        w.advance(w.now() + step);
+        ++advances;
+    }
+    bool once = true;
+    for (const Probe& p : probes) once = once && p.count == 1;
+    report(fired == want && once && next_ok && w.next_expiry() == kNever, "wheel: order vs sorted reference",
+           std::to_string(fired.size()) + " timers, " + std::to_string(advances) + " advances");
+}
+
+// A callback that re-arms itself, one that cancels a later timer and one
+// that moves a later timer.
+void wheel_callbacks() {
+    TimerWheel w;
+    std::vector<Tick> fired;
+    Probe periodic, canceller, victim, mover, moved;
+    for (Probe* p : {&periodic, &canceller, &victim, &mover, &moved}) p->attach(w, fired);
+
+    periodic.then = [](Probe& p) {
+        if (p.count < 10) p.wheel->insert(p, p.expires + 7);
+    };
+    canceller.then = [](Probe& p) { p.wheel->cancel(*p.other); };
+    canceller.other = &victim;
+    mover.then = [](Probe& p) { p.wheel->insert(*p.other, 5000); };
+    mover.other = &moved;
+
+    w.insert(periodic, 3);
+    w.insert(canceller, 20);
+    w.insert(victim, 300);
+    w.insert(mover, 40);
+    w.insert(moved, 100);
+    const std::size_t armed = w.size();
+    w.advance(10000);
+
+    const bool ok = armed == 5 && w.empty() && periodic.count == 10 && canceller.count == 1 && victim.count == 0 &&
+                    mover.count == 1 && moved.count == 1 && fired.back() == 5000 && !victim.armed();
+    report(ok, "wheel: cancel, re-arm in callbacks",
+           std::to_string(fired.size()) + " fired, " + std::to_string(w.size()) + " left");
+}
+
+// Timers due on the same tick fire as one batch; a callback that cancels or
+// re-arms a later member of its own batch must take effect.
+void wheel_same_batch() {
+    TimerWheel w;
+    std::vector<Tick> fired;
+    Probe a, b, c, d;
+    for (Probe* p : {&a, &b, &c, &d}) p->attach(w, fired);
+    // a and b cancel each other, so only whichever runs first fires.
+    a.then = b.then = [](Probe& p) { p.wheel->cancel(*p.other); };
+    a.other = &b;
+    b.other = &a;
+    // c and d each push the other out to 150 if it has not fired yet, so
+    // one fires at 50 and the other at 150.
+    c.then = d.then = [](Probe& p) {
+        if (p.other->count == 0) p.wheel->insert(*p.other, 150);
+    };
+    c.other = &d;
+    d.other = &c;
+
+    for (Probe* p : {&a, &b}) w.insert(*p, 10);
+    for (Probe* p : {&c, &d}) w.insert(*p, 50);
+    w.advance(1000);
+
+    const bool ok = a.count + b.count == 1 && c.count == 1 && d.count == 1 && fired == std::vector<Tick>{10, 50, 150} &&
+                    w.size() == 0 && w.empty();
+    report(ok, "wheel: cancel within a batch",
+           std::to_string(fired.size()) + " fired, " + std::to_string(w.size()) + " left");
+}
+
+// ---------------------------------------------------------------------------
+// Scheduler
+
+struct Wait {
+    bool result = false;
+    Tick at = kNever;
+};
+
+Task waiter(Scheduler& s, Event& e, Tick timeout, Wait& out) {
+    out.result = co_await e.wait_for(timeout);
+    out.at = s.now();
+}
+
+Task waiter(Scheduler& s, Event& e, Wait& out) {
+    out.result = co_await e.wait();
+    out.at = s.now();
+}
+
+Task setter(Scheduler& s, Event& e, Tick after) {
+    co_await s.sleep_for(after);
+    e.set();
+}
+
+void wait_for_timeouts() {
+    ManualClock clock;
+    Scheduler s(clock);
+    Event quiet(s), signalled(s), latched(s);
+    Wait a, b, c;
+    latched.set();
+    s.spawn(waiter(s, quiet, 100, a));
+    s.spawn(waiter(s, signalled, 100, b));
+    s.spawn(setter(s, signalled, 40));
+    s.spawn(waiter(s, latched, 100, c));
+    s.run();
+    const bool ok = !a.result && a.at == 100 && b.result && b.at == 40 && c.result && c.at == 0 && s.tasks() == 0 &&
+                    s.timers() == 0;
+    report(ok, "wait_for: timeout, set, latched",
+           "at " + std::to_string(a.at) + ", " + std::to_string(b.at) + ", " + std::to_string(c.at));
+}
+
+Task destroyer(Scheduler& s, std::unique_ptr<Event>& e, Tick after) {
+    co_await s.sleep_for(after);
+    e.reset();
+}
+
+// Destroying an Event resumes its waiters with false straight away and leaves
+// no timeout armed against the freed event.
+void event_destroyed() {
+    ManualClock clock;
+    Scheduler s(clock);
+    auto e = std::make_unique<Event>(s);
+    Wait timed, untimed;
+    s.spawn(waiter(s, *e, 1000, timed));
+    s.spawn(waiter(s, *e, untimed));
+    s.spawn(destroyer(s, e, 10));
+    s.run_until(5000);
+    const bool ok = !timed.result && timed.at == 10 && !untimed.result && untimed.at == 10 && s.tasks() == 0 &&
+                    s.timers() == 0;
+    report(ok, "event: destroyed with waiters", "resumed at " + std::to_string(timed.at) + ", " +
+                                                    std::to_string(untimed.at));
+}
+
+Task ticker(Scheduler& s, Tick period, int& count) {
+    for (;;) {
+        ++count;
+        co_await s.sleep_for(period);
+    }
+}
+
+Task forever(Event& e) { co_await e.wait(); }
+
+void run_until_limit() {
+    ManualClock clock;
+    Scheduler s(clock);
+    int count = 0;
+    s.spawn(ticker(s, 1000, count));
+    s.run_until(3500);
+    const Tick stopped = s.now();
+    const int first = count;
+    s.run_until(3500);
+    const bool again = count == first && s.now() == stopped;
+    s.run_until(10000);
+    const bool ok = first == 4 && stopped == 3500 && again && count == 11 && s.now() == 10000 && s.tasks() == 1;
+
+    // Blocked on an event with no timer armed: run() returns.
+    ManualClock idle_clock;
+    Scheduler idle(idle_clock);
+    Event never(idle);
+    idle.spawn(forever(never));
+    idle.run();
+    report(ok && idle.tasks() == 1 && idle.timers() == 0, "run_until: stops at the limit",
+           std::to_string(first) + " runs by 3500, " + std::to_string(count) + " by 10000");
+}
+
+}  // namespace
+
+int main() {
+    wheel_order();
+    wheel_callbacks();
+    wheel_same_batch();
+    wait_for_timeouts();
+    event_destroyed();
+    run_until_limit();
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+// Example firmware running on the simulator: a vibration sensor node.
+//
+//   TIM2 (1 kHz)  -> starts an ADC conversion on channel 3
+//   ADC0 EOC ISR  -> pushes the sample into an SPSC ring
+//   main loop     -> drains the ring, keeps a 32-sample moving RMS, polls the
+//                    I2C accelerometer every 10 ms and reports over UART
+//   GPIOA.0 ISR   -> button toggles the LED on GPIOA.5
+//   UART0 RX ISR  -> line commands: "rate <hz>", "stat"
+//
+//   g7_sim_sensor_node [stimulus] [--duration <time>] [--histograms]
+//
+// Exits non-zero if a timing budget is blown or samples were dropped.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "g7/sim/mcu.hpp"
+#include "g7/sim/peripherals.hpp"
+#include "g7/sim/stimulus.hpp"
+#include "g7/spsc_ring.hpp"
+
+using namespace g7::sim;
+
+namespace {
+
+constexpr int kAdcChannel = 3;
+constexpr int kButtonPin = 0;
+constexpr int kLedPin = 5;
+constexpr std::uint8_t kAccelAddr = 0x68;
+
+struct Node {
+    Mcu& mcu;
+    Timer& tim;
+    Adc& adc;
+    Gpio& gpio;
+    Uart& uart;
+    I2c& i2c;
+
+    g7::SpscRing<std::uint16_t, 64> samples{};
+    std::uint64_t dropped = 0;
+    char line[32] = {};
+    std::size_t line_len = 0;
+    char command[32] = {};
+    volatile bool command_ready = false;
+
+    double window[32] = {};
+    std::size_t window_pos = 0;
+    std::uint64_t processed = 0;
+    int accel_mg = 0;
+
+    void install() {
+        mcu.set_priority(adc.irq(), 1);
+        mcu.set_priority(tim.irq(), 2);
+        mcu.set_priority(uart.irq(), 3);
+        mcu.set_priority(gpio.irq(), 4);
+
+        mcu.set_handler(tim.irq(), [this] {
+            mcu.spend_cycles(40);
+            adc.start(kAdcChannel);
+        });
+        mcu.set_handler(adc.irq(), [this] {
+            mcu.spend_cycles(60);
+            if (!samples.push(adc.read())) ++dropped;
+        });
+        mcu.set_handler(gpio.irq(), [this] {
+            mcu.spend_cycles(30);
+            if (gpio.take_pending() & (1u << kButtonPin)) gpio.toggle(kLedPin);
+        });
+        mcu.set_handler(uart.irq(), [this] {
+            std::uint8_t b;
+            while (uart.read(b)) {
+                mcu.spend_cycles(25);
+                if (b == '\n') {
+                    line[line_len] = '\0';
+                    std::memcpy(command, line, sizeof(command));
+                    command_ready = true;
+                    line_len = 0;
+                } else if (line_len + 1 < sizeof(line)) {
+                    line[line_len++] = static_cast<char>(b);
+                }
+            }
+        });
+        for (int irq : {tim.irq(), adc.irq(), gpio.irq(), uart.irq()}) mcu.enable_irq(irq);
+        adc.enable_irq(true);
+        uart.enable_rx_irq(true);
+        gpio.set_edge_irq(kButtonPin, Edge::Rising);
+        tim.start(us(1000));
+    }
+
+    void process(std::uint16_t s) {
+        // Stand-in for the real filter: ~400 cycles per sample on an M4.
+        mcu.spend_cycles(400);
+        const double v = static_cast<double>(s) - 2048.0;
+        window[window_pos++ % 32] = v * v;
+        ++processed;
+        if (processed % 500 == 0) {
+            double sum = 0;
+            for (double w : window) sum += w;
+            char msg[64];
+            std::snprintf(msg, sizeof(msg), "t=%llums rms=%.0f az=%dmg\n",
+                          static_cast<unsigned long long>(mcu.now() / 1000000), std::sqrt(sum / 32), accel_mg);
+            uart.print(msg);
+        }
+    }
+
+    void poll_accel() {
+        std::uint8_t raw[2];
+        if (i2c.write_read(kAccelAddr, 0x3F, raw, 2)) {
+            accel_mg = static_cast<std::int16_t>((raw[0] << 8) | raw[1]);
+        }
+    }
+
+    void handle_command() {
+        command_ready = false;
+        if (std::strncmp(command, "rate ", 5) == 0) {
+            const long hz = std::strtol(command + 5, nullptr, 10);
+            if (hz > 0) tim.start(1000000000u / static_cast<Time>(hz));
+        } else if (std::strcmp(command, "stat") == 0) {
+            char msg[64];
+            std::snprintf(msg, sizeof(msg), "processed=%llu dropped=%llu\n",
+                          static_cast<unsigned long long>(processed), static_cast<unsigned long long>(dropped));
+            uart.print(msg);
+        }
+    }
+
+    void run(Time end) {
+        Time next_accel = 0;
+        while (mcu.now() < end) {
+            std::uint16_t s;
+            while (samples.pop(s)) process(s);
+            if (command_ready) handle_command();
+            if (mcu.now() >= next_accel) {
+                poll_accel();
+                next_accel = mcu.now() + ms(10);
+            }
+            mcu.wfi(end);
+        }
+    }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string stim = G7_SIM_EXAMPLES_DIR "/sensor_node.stim";
+    Time duration = sec(60);
+    bool histograms = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            const std::string d = argv[++i];
+            char* end = nullptr;
+            const double v = std::strtod(d.c_str(), &end);
+            const std::string unit(end);
+            duration = static_cast<Time>(v * (unit == "ms" ? 1e6 : unit == "us" ? 1e3 : 1e9));
+        } else if (std::strcmp(argv[i], "--histograms") == 0) {
+            histograms = true;
+        } else {
+            stim = argv[i];
+        }
+    }
+
+    Mcu mcu(48000000);
+    Node node{mcu,
+              mcu.add<Timer>("tim2"),
+              mcu.add<Adc>("adc0", 12, us(3)),
+              mcu.add<Gpio>("gpioa"),
+              mcu.add<Uart>("uart0", 115200),
+              mcu.add<I2c>("i2c1", 400000)};
+    node.install();
+
+    std::string error;
+    if (!load_stimulus(mcu, stim, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    mcu.set_budget(node.adc.irq(), us(10), us(5));
+    mcu.set_budget(node.tim.irq(), us(20), us(5));
+
+    const auto t0 = std::chrono::steady_clock::now();
+    node.run(duration);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    const double virt = static_cast<double>(mcu.now()) / 1e9;
+
+    std::printf("simulated %.3f s in %.3f s wall (%.0fx real time), core asleep %.1f%%\n", virt, wall,
+                virt / wall, 100.0 * static_cast<double>(mcu.sleep_time()) / static_cast<double>(mcu.now()));
+    std::printf("samples processed=%llu dropped=%llu adc_overruns=%llu uart_overruns=%llu "
+                "uart_tx=%zuB led_changes=%zu\n\n",
+                static_cast<unsigned long long>(node.processed), static_cast<unsigned long long>(node.dropped),
+                static_cast<unsigned long long>(node.adc.overruns()),
+                static_cast<unsigned long long>(node.uart.overruns()), node.uart.tx_data().size(),
+                node.gpio.output_log().size());
+    mcu.print_report(stdout);
+    if (histograms) {
+        for (int irq = 0; irq < mcu.irq_count(); ++irq) {
+            if (mcu.irq_stats(irq).raised) mcu.print_histograms(stdout, irq);
+        }
+    }
+    const bool ok = mcu.check_budgets(stdout) && node.dropped == 0;
+    return ok ? 0 : 1;
+}
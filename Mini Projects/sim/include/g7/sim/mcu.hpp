@@ -0,0 +1,186 @@
+// Deterministic host-side MCU model.
+//
+// Mcu owns a virtual clock (nanoseconds), an event queue, a Cortex-M style
+// interrupt controller and the simulated peripherals. Nothing waits on wall
+// time: when the firmware sleeps the clock jumps straight to the next event,
+// so recorded traces replay as fast as the host can run the handlers.
+//
+// Firmware CPU time is modelled explicitly: code calls spend()/spend_cycles()
+// for the work it stands for. Interrupts raised meanwhile preempt it exactly
+// as they would on the target (lower priority number wins), which is what
+// makes the per-ISR latency and execution-time numbers meaningful.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "g7/histogram.hpp"
+
+namespace g7::sim {
+
+using Time = std::uint64_t;  // virtual nanoseconds
+
+constexpr Time ns(std::uint64_t v) { return v; }
+constexpr Time us(std::uint64_t v) { return v * 1000u; }
+constexpr Time ms(std::uint64_t v) { return v * 1000000u; }
+constexpr Time sec(std::uint64_t v) { return v * 1000000000u; }
+
+class Mcu;
+
+// Base for simulated peripherals. Each one has a unique name that stimulus
+// files address as "<name>" or "<name>.<channel>".
+class Peripheral {
+public:
+    Peripheral(Mcu& mcu, std::string name) : mcu_(mcu), name_(std::move(name)) {}
+    virtual ~Peripheral() = default;
+    Peripheral(const Peripheral&) = delete;
+    Peripheral& operator=(const Peripheral&) = delete;
+
+    const std::string& name() const { return name_; }
+
+    // Validates one stimulus line and schedules its effect at time `at`.
+    // `base_dir` resolves relative file names. Returns false with `error`
+    // set when the command or its arguments are not understood.
+    virtual bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                          const std::string& base_dir, std::string& error) = 0;
+
+protected:
+    Mcu& mcu_;
+
+private:
+    std::string name_;
+};
+
+struct IrqStats {
+    Histogram latency;     // raise -> handler entry, virtual ns
+    Histogram exec;        // handler body excluding nested ISRs, virtual ns
+    Histogram host_exec;   // the same, measured in host ns
+    std::uint64_t raised = 0;
+    std::uint64_t coalesced = 0;  // raised again while still pending (lost edges)
+};
+
+class Mcu {
+public:
+    static constexpr int kThreadPriority = 1 << 30;
+
+    explicit Mcu(std::uint32_t core_hz = 48000000);
+    ~Mcu();
+
+    std::uint32_t core_hz() const { return core_hz_; }
+    Time now() const { return now_; }
+
+    // --- events --------------------------------------------------------
+    // Runs `fn` at absolute virtual time `at` (clamped to now()). Events at
+    // equal times run in scheduling order.
+    void schedule(Time at, std::function<void()> fn);
+    void after(Time delay, std::function<void()> fn) { schedule(now_ + delay, std::move(fn)); }
+
+    // --- interrupts ----------------------------------------------------
+    // Registers an interrupt line; returns its number. Peripherals call this.
+    int add_irq(const std::string& name, int priority = 8);
+    void set_handler(int irq, std::function<void()> handler);
+    void set_priority(int irq, int priority);
+    void enable_irq(int irq, bool enabled = true);
+    // Sets the pending bit. A second raise before the handler runs is
+    // counted as coalesced, like a lost edge on real hardware.
+    void raise(int irq);
+    // PRIMASK equivalents. Pending interrupts are serviced on re-enable.
+    void disable_interrupts() { masked_ = true; }
+    void enable_interrupts();
+    int find_irq(const std::string& name) const;
+    const std::string& irq_name(int irq) const { return irqs_[static_cast<std::size_t>(irq)].name; }
+    int irq_count() const { return static_cast<int>(irqs_.size()); }
+    const IrqStats& irq_stats(int irq) const { return irqs_[static_cast<std::size_t>(irq)].stats; }
+
+    // Cycles of fixed exception entry overhead (12 on Cortex-M3/M4).
+    void set_irq_entry_cycles(std::uint32_t cycles) { entry_cycles_ = cycles; }
+
+    // --- CPU time model ------------------------------------------------
+    // Consumes CPU time in the current context. Higher priority interrupts
+    // that become pending meanwhile run first; the caller still gets its
+    // full `duration` of CPU time.
+    void spend(Time duration);
+    void spend_cycles(std::uint64_t cycles) { spend(cycles_to_ns(cycles)); }
+    Time cycles_to_ns(std::uint64_t cycles) const {
+        return (cycles * 1000000000u + core_hz_ - 1) / core_hz_;
+    }
+
+    // Sleeps until at least one interrupt has been serviced, or until
+    // `deadline`. Returns false if nothing can wake the core before the
+    // deadline (the clock is then left at the deadline).
+    bool wfi(Time deadline = ~Time{0});
+    // Interrupt-driven firmware: sleep and service interrupts until `t`.
+    void run_until(Time t);
+    void run_for(Time d) { run_until(now_ + d); }
+
+    // Virtual time spent asleep in wfi()/run_until().
+    Time sleep_time() const { return sleep_ns_; }
+
+    // --- peripherals ---------------------------------------------------
+    template <typename P, typename... Args>
+    P& add(Args&&... args) {
+        auto p = std::make_unique<P>(*this, std::forward<Args>(args)...);
+        P& ref = *p;
+        peripherals_.push_back(std::move(p));
+        return ref;
+    }
+    Peripheral* find(const std::string& name) const;
+
+    // --- reporting -----------------------------------------------------
+    // Fails check_budgets() when any handler of `irq` exceeds either limit.
+    void set_budget(int irq, Time max_latency, Time max_exec);
+    // Prints every violated budget; returns true when all are met.
+    bool check_budgets(std::FILE* out) const;
+    // Per-ISR table of counts and latency/execution percentiles.
+    void print_report(std::FILE* out) const;
+    // Full latency and execution-time histograms for one interrupt.
+    void print_histograms(std::FILE* out, int irq) const;
+
+private:
+    struct Event {
+        Time at;
+        std::uint64_t seq;
+        std::function<void()> fn;
+        bool operator>(const Event& o) const { return at != o.at ? at > o.at : seq > o.seq; }
+    };
+
+    struct Irq {
+        std::string name;
+        int priority = 8;
+        bool enabled = false;
+        bool pending = false;
+        Time raised_at = 0;
+        std::function<void()> handler;
+        IrqStats stats;
+        Time budget_latency = 0;  // 0 = no budget
+        Time budget_exec = 0;
+    };
+
+    Time next_event_time() const { return events_.empty() ? ~Time{0} : events_.top().at; }
+    void run_events_at_now();
+    int next_serviceable() const;
+    void service_pending();
+    void dispatch(int irq);
+
+    std::uint32_t core_hz_;
+    std::uint32_t entry_cycles_ = 12;
+    Time now_ = 0;
+    Time sleep_ns_ = 0;
+    std::uint64_t seq_ = 0;
+    bool masked_ = false;
+    int current_priority_ = kThreadPriority;
+    // Virtual and host time consumed by nested handlers, per active frame.
+    std::vector<std::pair<Time, std::uint64_t>> nested_;
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+    std::vector<Irq> irqs_;
+    std::vector<std::unique_ptr<Peripheral>> peripherals_;
+};
+
+}  // namespace g7::sim
@@ -0,0 +1,293 @@
+// Simulated peripherals: GPIO, UART, SPI, I2C, ADC and timers.
+//
+// Each peripheral registers its own interrupt line with the Mcu (named after
+// the peripheral) and exposes a register-level-ish API that firmware calls
+// instead of touching hardware. Bus transfers take virtual time derived from
+// the configured bit rate; blocking calls consume it with Mcu::spend().
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "g7/sim/mcu.hpp"
+#include "g7/sim/trace.hpp"
+
+namespace g7::sim {
+
+// --- GPIO ----------------------------------------------------------------
+
+enum class Edge : std::uint8_t { None, Rising, Falling, Both };
+
+class Gpio : public Peripheral {
+public:
+    static constexpr int kMaxPins = 32;
+
+    Gpio(Mcu& mcu, std::string name, int pins = 16, int priority = 8);
+
+    void write(int pin, bool level);
+    void toggle(int pin) { write(pin, !read(pin)); }
+    bool read(int pin) const { return (levels_ >> pin) & 1u; }
+    // EXTI-style edge detection; all pins share the port interrupt.
+    void set_edge_irq(int pin, Edge edge);
+    // Returns and clears the mask of pins whose edge fired.
+    std::uint32_t take_pending();
+    int irq() const { return irq_; }
+
+    // External drive of an input pin.
+    void drive(int pin, bool level);
+
+    struct Change {
+        Time at;
+        int pin;
+        bool level;
+    };
+    // Every output write that changed a pin, in time order.
+    const std::vector<Change>& output_log() const { return log_; }
+
+    // "<port>.<pin> set 0|1", "<port>.<pin> pulse <width>"
+    bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                  const std::string& base_dir, std::string& error) override;
+
+private:
+    int pins_;
+    int irq_;
+    std::uint32_t levels_ = 0;
+    std::uint32_t pending_ = 0;
+    std::array<Edge, kMaxPins> edges_{};
+    std::vector<Change> log_;
+};
+
+// --- UART ----------------------------------------------------------------
+
+class Uart : public Peripheral {
+public:
+    static constexpr std::size_t kTxFifo = 16;
+
+    Uart(Mcu& mcu, std::string name, std::uint32_t baud = 115200, int priority = 8);
+
+    Time byte_time() const { return byte_time_; }
+    int irq() const { return irq_; }
+    void enable_rx_irq(bool on) { rx_irq_ = on; }
+    // Raised when the TX FIFO drains.
+    void enable_tx_irq(bool on) { tx_irq_ = on; }
+
+    // Queues one byte; false when the FIFO is full.
+    bool write(std::uint8_t b);
+    // Blocking write: spends CPU time waiting for FIFO space.
+    void print(const std::string& s);
+    bool tx_busy() const { return !tx_fifo_.empty(); }
+    // Everything that has left the shift register so far.
+    const std::string& tx_data() const { return tx_data_; }
+    void set_echo(std::FILE* out) { echo_ = out; }
+
+    // Reads the receive register; false when it is empty.
+    bool read(std::uint8_t& b);
+    std::uint64_t overruns() const { return overruns_; }
+
+    // Feeds bytes into RX back to back at line rate, starting at `at`.
+    void inject(Time at, const std::string& bytes);
+
+    // "<uart> rx <text...>" (C escapes allowed), "<uart> rx_hex <bytes...>"
+    bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                  const std::string& base_dir, std::string& error) override;
+
+private:
+    void tx_next();
+
+    Time byte_time_;
+    int irq_;
+    bool rx_irq_ = false;
+    bool tx_irq_ = false;
+    std::deque<std::uint8_t> tx_fifo_;
+    std::string tx_data_;
+    std::FILE* echo_ = nullptr;
+    Time rx_free_at_ = 0;
+    bool rx_full_ = false;
+    std::uint8_t rx_data_ = 0;
+    std::uint64_t overruns_ = 0;
+};
+
+// --- SPI -----------------------------------------------------------------
+
+class SpiDevice {
+public:
+    virtual ~SpiDevice() = default;
+    virtual void select() {}
+    virtual std::uint8_t exchange(std::uint8_t mosi) = 0;
+    virtual void deselect() {}
+};
+
+class Spi : public Peripheral {
+public:
+    Spi(Mcu& mcu, std::string name, std::uint32_t clock_hz = 8000000, int priority = 8);
+
+    int irq() const { return irq_; }
+    void attach(SpiDevice* dev) { dev_ = dev; }
+
+    // Full-duplex transfer with chip select held; rx may be null. Blocks
+    // for the bus time.
+    void transfer(const std::uint8_t* tx, std::uint8_t* rx, std::size_t n);
+    // DMA-style: returns at once and raises the interrupt on completion.
+    // Buffers must stay valid until then. False while a transfer is active.
+    bool transfer_async(const std::uint8_t* tx, std::uint8_t* rx, std::size_t n);
+    bool busy() const { return busy_; }
+
+    // "<spi> miso <hex bytes...>": bytes returned when no device is attached.
+    bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                  const std::string& base_dir, std::string& error) override;
+
+private:
+    void exchange_all(const std::uint8_t* tx, std::uint8_t* rx, std::size_t n);
+
+    Time bit_time_;
+    int irq_;
+    SpiDevice* dev_ = nullptr;
+    bool busy_ = false;
+    std::deque<std::uint8_t> miso_;
+};
+
+// --- I2C -----------------------------------------------------------------
+
+class I2cDevice {
+public:
+    virtual ~I2cDevice() = default;
+    // Return false to NACK.
+    virtual bool write(const std::uint8_t* data, std::size_t n) = 0;
+    virtual bool read(std::uint8_t* data, std::size_t n) = 0;
+};
+
+// Generic sensor: 256 byte registers with an auto-incrementing pointer set
+// by the first written byte. Register pairs can follow a trace as
+// big-endian int16, which is how most MEMS sensors present samples.
+class I2cRegisterDevice : public I2cDevice {
+public:
+    explicit I2cRegisterDevice(const Mcu& mcu) : mcu_(mcu) {}
+
+    bool write(const std::uint8_t* data, std::size_t n) override;
+    bool read(std::uint8_t* data, std::size_t n) override;
+
+    void set_reg(std::uint8_t reg, std::uint8_t v) { regs_[reg] = v; }
+    std::uint8_t reg(std::uint8_t reg) const { return regs_[reg]; }
+    void attach_trace(std::uint8_t reg, Trace trace) { traces_[reg] = std::move(trace); }
+
+private:
+    std::uint8_t load(std::uint8_t reg) const;
+
+    const Mcu& mcu_;
+    std::array<std::uint8_t, 256> regs_{};
+    std::uint8_t ptr_ = 0;
+    std::map<std::uint8_t, Trace> traces_;
+};
+
+class I2c : public Peripheral {
+public:
+    I2c(Mcu& mcu, std::string name, std::uint32_t bus_hz = 400000);
+
+    void attach(std::uint8_t addr, I2cDevice& dev) { devs_[addr] = &dev; }
+
+    // Blocking transactions; false on address NACK.
+    bool write(std::uint8_t addr, const std::uint8_t* data, std::size_t n);
+    bool read(std::uint8_t addr, std::uint8_t* data, std::size_t n);
+    bool write_read(std::uint8_t addr, std::uint8_t reg, std::uint8_t* data, std::size_t n);
+    std::uint64_t nacks() const { return nacks_; }
+
+    // "<bus>.<addr> reg <r> <bytes...>", "<bus>.<addr> trace <r> <file> rate=.. col=.. scale=.. loop"
+    // Creates an I2cRegisterDevice at <addr> when nothing is attached there.
+    bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                  const std::string& base_dir, std::string& error) override;
+
+private:
+    // Start + address + n data bytes + stop, 9 bit times per byte.
+    void bus_time(std::size_t bytes) { mcu_.spend(bit_time_ * (9 * (bytes + 1) + 2)); }
+    I2cRegisterDevice* reg_device(std::uint8_t addr);
+
+    Time bit_time_;
+    std::map<std::uint8_t, I2cDevice*> devs_;
+    std::vector<std::unique_ptr<I2cRegisterDevice>> owned_;
+    std::uint64_t nacks_ = 0;
+};
+
+// --- ADC -----------------------------------------------------------------
+
+class Adc : public Peripheral {
+public:
+    static constexpr int kMaxChannels = 32;
+
+    Adc(Mcu& mcu, std::string name, int bits = 12, Time conversion = us(2), int priority = 8);
+
+    int irq() const { return irq_; }
+    void enable_irq(bool on) { irq_on_ = on; }
+
+    // Starts one conversion; the result register and EOC interrupt follow
+    // after the conversion time. False while busy.
+    bool start(int channel);
+    bool busy() const { return busy_; }
+    bool eoc() const { return eoc_; }
+    // Reads the result register and clears EOC.
+    std::uint16_t read();
+    // Starts a conversion and spends the CPU time waiting for it.
+    std::uint16_t convert(int channel);
+    // Conversions that completed while the previous result was unread.
+    std::uint64_t overruns() const { return overruns_; }
+
+    void set_level(int channel, double counts);
+    void attach_trace(int channel, Trace trace);
+
+    // "<adc>.<ch> set <counts>", "<adc>.<ch> trace <file> rate=.. col=.. scale=.. offset=.. loop"
+    bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                  const std::string& base_dir, std::string& error) override;
+
+private:
+    std::uint16_t sample(int channel) const;
+
+    std::uint16_t max_code_;
+    Time conversion_;
+    int irq_;
+    bool irq_on_ = false;
+    bool busy_ = false;
+    bool eoc_ = false;
+    std::uint16_t result_ = 0;
+    std::uint64_t overruns_ = 0;
+    std::array<double, kMaxChannels> levels_{};
+    std::array<std::unique_ptr<Trace>, kMaxChannels> traces_{};
+};
+
+// --- Timer ---------------------------------------------------------------
+
+class Timer : public Peripheral {
+public:
+    Timer(Mcu& mcu, std::string name, int priority = 8);
+
+    int irq() const { return irq_; }
+    // Raises the update interrupt every `period` (or once).
+    void start(Time period, bool periodic = true);
+    void stop() { ++generation_; running_ = false; }
+    bool running() const { return running_; }
+    std::uint64_t updates() const { return updates_; }
+    // Time since the last update event, like reading CNT.
+    Time counter() const { return mcu_.now() - last_update_; }
+
+    // "<timer> start <period> [once]", "<timer> stop"
+    bool stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                  const std::string& base_dir, std::string& error) override;
+
+private:
+    void arm(Time at, std::uint64_t gen);
+
+    int irq_;
+    Time period_ = 0;
+    bool periodic_ = true;
+    bool running_ = false;
+    std::uint64_t generation_ = 0;
+    std::uint64_t updates_ = 0;
+    Time last_update_ = 0;
+};
+
+}  // namespace g7::sim
@@ -0,0 +1,35 @@
+// Scripted stimulus files.
+//
+// One action per line, scheduled on the virtual clock:
+//
+//   # time     target       command  args...
+//   0          adc0.3       trace    accel_x.csv rate=1000 loop
+//   10us       gpioa.0      set      1
+//   +2ms       gpioa.0      pulse    50us
+//   1ms        uart0        rx       "AT+SEND\r\n"
+//   5ms        i2c1.0x68    reg      3b 12 34
+//   1s         tim2         stop
+//
+// Times take ns/us/ms/s suffixes (bare numbers are ns); a leading '+' makes
+// the time relative to the previous line. Targets are peripheral names,
+// optionally followed by ".<channel>". Double quotes group an argument and
+// '#' starts a comment. Relative file names resolve against the directory
+// of the stimulus file.
+#pragma once
+
+#include <string>
+
+#include "g7/sim/mcu.hpp"
+
+namespace g7::sim {
+
+// Parses and schedules every line of `path`. Returns false and sets `error`
+// ("file:line: message") at the first bad line. Callers should treat that
+// as fatal: the lines before it have already been scheduled.
+bool load_stimulus(Mcu& mcu, const std::string& path, std::string& error);
+
+// Schedules the lines of `text` as if read from a file in `base_dir`.
+bool load_stimulus_text(Mcu& mcu, const std::string& text, const std::string& base_dir,
+                        std::string& error);
+
+}  // namespace g7::sim
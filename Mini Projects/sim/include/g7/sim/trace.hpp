@@ -0,0 +1,41 @@
+// Recorded sensor trace, replayed against the virtual clock.
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "g7/sim/mcu.hpp"
+
+namespace g7::sim {
+
+class Trace {
+public:
+    // Loads a CSV/whitespace separated file. With rate_hz > 0 column `col`
+    // holds samples taken at that rate; with rate_hz == 0 column 0 is the
+    // timestamp in seconds and `col` the value. Lines that do not parse (a
+    // header, comments) are skipped.
+    bool load(const std::string& path, double rate_hz, std::size_t col, std::string& error);
+    void set_samples(std::vector<double> values, double rate_hz);
+
+    // Zero-order hold: the most recent sample at virtual time `t`. Before
+    // `start` the first sample is held; past the end the last one, unless
+    // `loop` is set.
+    double at(Time t) const;
+
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    Time duration() const;
+
+    Time start = 0;
+    bool loop = false;
+    double scale = 1.0;
+    double offset = 0.0;
+
+private:
+    std::vector<double> values_;
+    std::vector<Time> times_;  // empty when uniformly sampled
+    Time period_ = 0;
+};
+
+}  // namespace g7::sim
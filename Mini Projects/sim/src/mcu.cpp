@@ -0,0 +1,227 @@
+#include "g7/sim/mcu.hpp"
+
+#include "g7/cycles.hpp"
+
+namespace g7::sim {
+
+Mcu::Mcu(std::uint32_t core_hz) : core_hz_(core_hz) {}
+
+Mcu::~Mcu() = default;
+
+void Mcu::schedule(Time at, std::function<void()> fn) {
+    events_.push(Event{at < now_ ? now_ : at, seq_++, std::move(fn)});
+}
+
+int Mcu::add_irq(const std::string& name, int priority) {
+    // In place: an Irq carries three histograms, ~23 KiB, too much for a
+    // temporary on the stack.
+    Irq& irq = irqs_.emplace_back();
+    irq.name = name;
+    irq.priority = priority;
+    return static_cast<int>(irqs_.size()) - 1;
+}
+
+void Mcu::set_handler(int irq, std::function<void()> handler) {
+    irqs_[static_cast<std::size_t>(irq)].handler = std::move(handler);
+}
+
+void Mcu::set_priority(int irq, int priority) { irqs_[static_cast<std::size_t>(irq)].priority = priority; }
+
+void Mcu::enable_irq(int irq, bool enabled) { irqs_[static_cast<std::size_t>(irq)].enabled = enabled; }
+
+void Mcu::raise(int irq) {
+    Irq& q = irqs_[static_cast<std::size_t>(irq)];
+    ++q.stats.raised;
+    if (q.pending) {
+        ++q.stats.coalesced;
+        return;
+    }
+    q.pending = true;
+    q.raised_at = now_;
+}
+
+void Mcu::enable_interrupts() {
+    masked_ = false;
+    service_pending();
+}
+
+int Mcu::find_irq(const std::string& name) const {
+    for (std::size_t i = 0; i < irqs_.size(); ++i) {
+        if (irqs_[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void Mcu::run_events_at_now() {
+    while (!events_.empty() && events_.top().at <= now_) {
+        std::function<void()> fn = std::move(const_cast<Event&>(events_.top()).fn);
+        events_.pop();
+        fn();
+    }
+}
+
+int Mcu::next_serviceable() const {
+    if (masked_) {
+        return -1;
+    }
+    int best = -1;
+    for (std::size_t i = 0; i < irqs_.size(); ++i) {
+        const Irq& q = irqs_[i];
+        if (q.pending && q.enabled && q.priority < current_priority_ &&
+            (best < 0 || q.priority < irqs_[static_cast<std::size_t>(best)].priority)) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+void Mcu::service_pending() {
+    for (int irq = next_serviceable(); irq >= 0; irq = next_serviceable()) {
+        dispatch(irq);
+    }
+}
+
+void Mcu::dispatch(int irq) {
+    const auto idx = static_cast<std::size_t>(irq);
+    const Time frame_start = now_;
+    const std::uint64_t host_frame_start = cycles::now();
+    const int saved_priority = current_priority_;
+
+    irqs_[idx].pending = false;
+    current_priority_ = irqs_[idx].priority;
+    nested_.emplace_back(0, 0);
+    // Exception entry (stacking, vector fetch). A higher priority interrupt
+    // arriving now preempts before the handler starts and adds to latency.
+    spend(cycles_to_ns(entry_cycles_));
+    irqs_[idx].stats.latency.add(now_ - irqs_[idx].raised_at);
+
+    const auto [entry_virtual, entry_host] = nested_.back();
+    const Time body_start = now_;
+    const std::uint64_t host_body_start = cycles::now();
+    if (irqs_[idx].handler) {
+        irqs_[idx].handler();
+    }
+    const std::uint64_t host_body = cycles::now() - host_body_start;
+    const auto [nested_virtual, nested_host] = nested_.back();
+    nested_.pop_back();
+
+    IrqStats& st = irqs_[idx].stats;
+    st.exec.add(now_ - body_start - (nested_virtual - entry_virtual));
+    st.host_exec.add(static_cast<std::uint64_t>(cycles::to_ns(host_body - (nested_host - entry_host))));
+
+    current_priority_ = saved_priority;
+    if (!nested_.empty()) {
+        nested_.back().first += now_ - frame_start;
+        nested_.back().second += cycles::now() - host_frame_start;
+    }
+}
+
+void Mcu::spend(Time duration) {
+    Time remaining = duration;
+    for (;;) {
+        service_pending();
+        if (remaining == 0) {
+            return;
+        }
+        const Time next = next_event_time();
+        const Time step = next <= now_ ? 0 : next - now_ < remaining ? next - now_ : remaining;
+        now_ += step;
+        remaining -= step;
+        run_events_at_now();
+    }
+}
+
+bool Mcu::wfi(Time deadline) {
+    if (next_serviceable() >= 0) {
+        service_pending();
+        return true;
+    }
+    for (;;) {
+        if (events_.empty() || next_event_time() > deadline) {
+            if (deadline != ~Time{0} && deadline > now_) {
+                sleep_ns_ += deadline - now_;
+                now_ = deadline;
+            }
+            return false;
+        }
+        const Time next = next_event_time();
+        if (next > now_) {
+            sleep_ns_ += next - now_;
+            now_ = next;
+        }
+        run_events_at_now();
+        if (next_serviceable() >= 0) {
+            service_pending();
+            return true;
+        }
+    }
+}
+
+void Mcu::run_until(Time t) {
+    while (wfi(t)) {
+    }
+}
+
+Peripheral* Mcu::find(const std::string& name) const {
+    for (const auto& p : peripherals_) {
+        if (p->name() == name) {
+            return p.get();
+        }
+    }
+    return nullptr;
+}
+
+void Mcu::set_budget(int irq, Time max_latency, Time max_exec) {
+    irqs_[static_cast<std::size_t>(irq)].budget_latency = max_latency;
+    irqs_[static_cast<std::size_t>(irq)].budget_exec = max_exec;
+}
+
+bool Mcu::check_budgets(std::FILE* out) const {
+    bool ok = true;
+    for (const Irq& q : irqs_) {
+        if (q.budget_latency && q.stats.latency.max() > q.budget_latency) {
+            std::fprintf(out, "BUDGET %s: worst latency %llu ns > %llu ns\n", q.name.c_str(),
+                         static_cast<unsigned long long>(q.stats.latency.max()),
+                         static_cast<unsigned long long>(q.budget_latency));
+            ok = false;
+        }
+        if (q.budget_exec && q.stats.exec.max() > q.budget_exec) {
+            std::fprintf(out, "BUDGET %s: worst execution %llu ns > %llu ns\n", q.name.c_str(),
+                         static_cast<unsigned long long>(q.stats.exec.max()),
+                         static_cast<unsigned long long>(q.budget_exec));
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void Mcu::print_report(std::FILE* out) const {
+    auto us_of = [](std::uint64_t v) { return static_cast<double>(v) / 1000.0; };
+    std::fprintf(out, "%-14s %4s %9s %6s | %9s %9s %9s | %9s %9s %9s | %9s\n", "irq", "prio", "count",
+                 "lost", "lat p50", "lat p99", "lat max", "exec p50", "exec p99", "WCET", "host max");
+    std::fprintf(out, "%-14s %4s %9s %6s | %29s | %29s | %9s\n", "", "", "", "", "(us, virtual)",
+                 "(us, virtual)", "(us)");
+    for (const Irq& q : irqs_) {
+        const IrqStats& s = q.stats;
+        if (s.raised == 0) {
+            continue;
+        }
+        std::fprintf(out, "%-14s %4d %9llu %6llu | %9.2f %9.2f %9.2f | %9.2f %9.2f %9.2f | %9.2f\n",
+                     q.name.c_str(), q.priority, static_cast<unsigned long long>(s.latency.count()),
+                     static_cast<unsigned long long>(s.coalesced), us_of(s.latency.percentile(50)),
+                     us_of(s.latency.percentile(99)), us_of(s.latency.max()), us_of(s.exec.percentile(50)),
+                     us_of(s.exec.percentile(99)), us_of(s.exec.max()), us_of(s.host_exec.max()));
+    }
+}
+
+void Mcu::print_histograms(std::FILE* out, int irq) const {
+    const Irq& q = irqs_[static_cast<std::size_t>(irq)];
+    std::fprintf(out, "%s latency (virtual):\n", q.name.c_str());
+    q.stats.latency.print_bars(out, "ns");
+    std::fprintf(out, "%s execution time (virtual):\n", q.name.c_str());
+    q.stats.exec.print_bars(out, "ns");
+}
+
+}  // namespace g7::sim
@@ -0,0 +1,110 @@
+// Small parsing helpers shared by the stimulus loader and the peripherals.
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "g7/sim/mcu.hpp"
+
+namespace g7::sim::detail {
+
+// "250", "250ns", "10us", "3ms", "1.5s"; a bare number is nanoseconds.
+inline bool parse_time(const std::string& s, Time& out) {
+    char* end = nullptr;
+    const double v = std::strtod(s.c_str(), &end);
+    if (end == s.c_str() || v < 0) {
+        return false;
+    }
+    const std::string unit(end);
+    double scale = 1.0;
+    if (unit.empty() || unit == "ns") {
+        scale = 1.0;
+    } else if (unit == "us") {
+        scale = 1e3;
+    } else if (unit == "ms") {
+        scale = 1e6;
+    } else if (unit == "s") {
+        scale = 1e9;
+    } else {
+        return false;
+    }
+    out = static_cast<Time>(v * scale + 0.5);
+    return true;
+}
+
+// Decimal or 0x-prefixed hex.
+inline bool parse_int(const std::string& s, long long& out) {
+    char* end = nullptr;
+    out = std::strtoll(s.c_str(), &end, 0);
+    return end != s.c_str() && *end == '\0';
+}
+
+// Bare hex byte ("3b", "0x3B").
+inline bool parse_hex_byte(const std::string& s, std::uint8_t& out) {
+    char* end = nullptr;
+    const unsigned long v = std::strtoul(s.c_str(), &end, 16);
+    if (end == s.c_str() || *end != '\0' || v > 0xFF) {
+        return false;
+    }
+    out = static_cast<std::uint8_t>(v);
+    return true;
+}
+
+inline bool parse_double(const std::string& s, double& out) {
+    char* end = nullptr;
+    out = std::strtod(s.c_str(), &end);
+    return end != s.c_str() && *end == '\0';
+}
+
+// Options of the form key=value or bare flags among `args` from `first` on.
+struct TraceOptions {
+    double rate = 0.0;
+    std::size_t col = 0;
+    bool col_set = false;
+    double scale = 1.0;
+    double offset = 0.0;
+    bool loop = false;
+};
+
+inline bool parse_trace_options(const std::vector<std::string>& args, std::size_t first, TraceOptions& o,
+                                std::string& error) {
+    for (std::size_t i = first; i < args.size(); ++i) {
+        const std::string& a = args[i];
+        const auto eq = a.find('=');
+        const std::string key = a.substr(0, eq);
+        const std::string val = eq == std::string::npos ? "" : a.substr(eq + 1);
+        long long n = 0;
+        bool ok = true;
+        if (key == "loop" && eq == std::string::npos) {
+            o.loop = true;
+        } else if (key == "rate") {
+            ok = parse_double(val, o.rate) && o.rate > 0;
+        } else if (key == "col") {
+            ok = parse_int(val, n) && n >= 0;
+            o.col = static_cast<std::size_t>(n);
+            o.col_set = true;
+        } else if (key == "scale") {
+            ok = parse_double(val, o.scale);
+        } else if (key == "offset") {
+            ok = parse_double(val, o.offset);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            error = "bad trace option '" + a + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+inline std::string resolve_path(const std::string& base_dir, const std::string& path) {
+    if (path.empty() || path[0] == '/' || base_dir.empty()) {
+        return path;
+    }
+    return base_dir + "/" + path;
+}
+
+}  // namespace g7::sim::detail
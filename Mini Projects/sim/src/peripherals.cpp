@@ -0,0 +1,549 @@
+#include "g7/sim/peripherals.hpp"
+
+#include <cmath>
+
+#include "parse.hpp"
+
+namespace g7::sim {
+
+namespace {
+
+bool expect_args(const std::vector<std::string>& args, std::size_t n, const char* usage,
+                 std::string& error) {
+    if (args.size() < n) {
+        error = std::string("usage: ") + usage;
+        return false;
+    }
+    return true;
+}
+
+bool parse_channel(const std::string& channel, int limit, int& out, std::string& error) {
+    long long v = 0;
+    if (!detail::parse_int(channel, v) || v < 0 || v >= limit) {
+        error = "bad channel '" + channel + "'";
+        return false;
+    }
+    out = static_cast<int>(v);
+    return true;
+}
+
+bool load_trace(const std::vector<std::string>& args, std::size_t file_arg, const std::string& base_dir,
+                Time at, Trace& trace, std::string& error) {
+    detail::TraceOptions opt;
+    if (!detail::parse_trace_options(args, file_arg + 1, opt, error)) {
+        return false;
+    }
+    // Timestamped traces keep the value in column 1 unless told otherwise.
+    const std::size_t col = opt.col_set ? opt.col : opt.rate > 0 ? 0 : 1;
+    if (!trace.load(detail::resolve_path(base_dir, args[file_arg]), opt.rate, col, error)) {
+        return false;
+    }
+    trace.start = at;
+    trace.loop = opt.loop;
+    trace.scale = opt.scale;
+    trace.offset = opt.offset;
+    return true;
+}
+
+// Handles C-style escapes in UART text stimulus.
+std::string unescape(const std::string& s) {
+    std::string out;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (s[i] != '\\' || i + 1 == s.size()) {
+            out += s[i];
+            continue;
+        }
+        switch (s[++i]) {
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case '0': out += '\0'; break;
+            case 's': out += ' '; break;
+            default: out += s[i]; break;
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+// --- GPIO ----------------------------------------------------------------
+
+Gpio::Gpio(Mcu& mcu, std::string name, int pins, int priority)
+    : Peripheral(mcu, name), pins_(pins < kMaxPins ? pins : kMaxPins), irq_(mcu.add_irq(name, priority)) {}
+
+void Gpio::write(int pin, bool level) {
+    if (read(pin) == level) {
+        return;
+    }
+    levels_ ^= 1u << pin;
+    log_.push_back(Change{mcu_.now(), pin, level});
+}
+
+void Gpio::set_edge_irq(int pin, Edge edge) { edges_[static_cast<std::size_t>(pin)] = edge; }
+
+std::uint32_t Gpio::take_pending() {
+    const std::uint32_t p = pending_;
+    pending_ = 0;
+    return p;
+}
+
+void Gpio::drive(int pin, bool level) {
+    if (read(pin) == level) {
+        return;
+    }
+    levels_ ^= 1u << pin;
+    const Edge e = edges_[static_cast<std::size_t>(pin)];
+    if (e == Edge::Both || (e == Edge::Rising && level) || (e == Edge::Falling && !level)) {
+        pending_ |= 1u << pin;
+        mcu_.raise(irq_);
+    }
+}
+
+bool Gpio::stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                    const std::string&, std::string& error) {
+    int pin = 0;
+    if (!parse_channel(channel, pins_, pin, error) || !expect_args(args, 2, "<port>.<pin> set|pulse <arg>", error)) {
+        return false;
+    }
+    if (args[0] == "set") {
+        const bool level = args[1] != "0";
+        mcu_.schedule(at, [this, pin, level] { drive(pin, level); });
+        return true;
+    }
+    if (args[0] == "pulse") {
+        Time width = 0;
+        if (!detail::parse_time(args[1], width)) {
+            error = "bad pulse width '" + args[1] + "'";
+            return false;
+        }
+        mcu_.schedule(at, [this, pin] { drive(pin, !read(pin)); });
+        mcu_.schedule(at + width, [this, pin] { drive(pin, !read(pin)); });
+        return true;
+    }
+    error = "unknown gpio command '" + args[0] + "'";
+    return false;
+}
+
+// --- UART ----------------------------------------------------------------
+
+Uart::Uart(Mcu& mcu, std::string name, std::uint32_t baud, int priority)
+    : Peripheral(mcu, name),
+      // 8N1: start + 8 data + stop bits per byte.
+      byte_time_((10ull * 1000000000ull + baud - 1) / baud),
+      irq_(mcu.add_irq(name, priority)) {}
+
+bool Uart::write(std::uint8_t b) {
+    if (tx_fifo_.size() >= kTxFifo) {
+        return false;
+    }
+    tx_fifo_.push_back(b);
+    if (tx_fifo_.size() == 1) {
+        mcu_.after(byte_time_, [this] { tx_next(); });
+    }
+    return true;
+}
+
+void Uart::tx_next() {
+    const std::uint8_t b = tx_fifo_.front();
+    tx_fifo_.pop_front();
+    tx_data_ += static_cast<char>(b);
+    if (echo_) {
+        std::fputc(b, echo_);
+    }
+    if (!tx_fifo_.empty()) {
+        mcu_.after(byte_time_, [this] { tx_next(); });
+    } else if (tx_irq_) {
+        mcu_.raise(irq_);
+    }
+}
+
+void Uart::print(const std::string& s) {
+    for (char c : s) {
+        while (!write(static_cast<std::uint8_t>(c))) {
+            mcu_.spend(byte_time_ / 4);
+        }
+    }
+}
+
+bool Uart::read(std::uint8_t& b) {
+    if (!rx_full_) {
+        return false;
+    }
+    b = rx_data_;
+    rx_full_ = false;
+    return true;
+}
+
+void Uart::inject(Time at, const std::string& bytes) {
+    Time t = at > rx_free_at_ ? at : rx_free_at_;
+    for (char c : bytes) {
+        t += byte_time_;
+        mcu_.schedule(t, [this, c] {
+            if (rx_full_) {
+                ++overruns_;
+                return;
+            }
+            rx_data_ = static_cast<std::uint8_t>(c);
+            rx_full_ = true;
+            if (rx_irq_) {
+                mcu_.raise(irq_);
+            }
+        });
+    }
+    rx_free_at_ = t;
+}
+
+bool Uart::stimulus(Time at, const std::string&, const std::vector<std::string>& args,
+                    const std::string&, std::string& error) {
+    if (!expect_args(args, 2, "<uart> rx <text> | rx_hex <bytes...>", error)) {
+        return false;
+    }
+    std::string bytes;
+    if (args[0] == "rx") {
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            if (i > 1) bytes += ' ';
+            bytes += unescape(args[i]);
+        }
+    } else if (args[0] == "rx_hex") {
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            std::uint8_t b = 0;
+            if (!detail::parse_hex_byte(args[i], b)) {
+                error = "bad hex byte '" + args[i] + "'";
+                return false;
+            }
+            bytes += static_cast<char>(b);
+        }
+    } else {
+        error = "unknown uart command '" + args[0] + "'";
+        return false;
+    }
+    inject(at, bytes);
+    return true;
+}
+
+// --- SPI -----------------------------------------------------------------
+
+Spi::Spi(Mcu& mcu, std::string name, std::uint32_t clock_hz, int priority)
+    : Peripheral(mcu, name),
+      bit_time_((1000000000ull + clock_hz - 1) / clock_hz),
+      irq_(mcu.add_irq(name, priority)) {}
+
+void Spi::exchange_all(const std::uint8_t* tx, std::uint8_t* rx, std::size_t n) {
+    if (dev_) dev_->select();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint8_t mosi = tx ? tx[i] : 0xFF;
+        std::uint8_t miso = 0xFF;
+        if (dev_) {
+            miso = dev_->exchange(mosi);
+        } else if (!miso_.empty()) {
+            miso = miso_.front();
+            miso_.pop_front();
+        }
+        if (rx) rx[i] = miso;
+    }
+    if (dev_) dev_->deselect();
+}
+
+void Spi::transfer(const std::uint8_t* tx, std::uint8_t* rx, std::size_t n) {
+    busy_ = true;
+    mcu_.spend(bit_time_ * 8 * n);
+    exchange_all(tx, rx, n);
+    busy_ = false;
+}
+
+bool Spi::transfer_async(const std::uint8_t* tx, std::uint8_t* rx, std::size_t n) {
+    if (busy_) {
+        return false;
+    }
+    busy_ = true;
+    mcu_.after(bit_time_ * 8 * n, [this, tx, rx, n] {
+        exchange_all(tx, rx, n);
+        busy_ = false;
+        mcu_.raise(irq_);
+    });
+    return true;
+}
+
+bool Spi::stimulus(Time at, const std::string&, const std::vector<std::string>& args,
+                   const std::string&, std::string& error) {
+    if (!expect_args(args, 2, "<spi> miso <hex bytes...>", error)) {
+        return false;
+    }
+    if (args[0] != "miso") {
+        error = "unknown spi command '" + args[0] + "'";
+        return false;
+    }
+    std::vector<std::uint8_t> bytes;
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        std::uint8_t b = 0;
+        if (!detail::parse_hex_byte(args[i], b)) {
+            error = "bad hex byte '" + args[i] + "'";
+            return false;
+        }
+        bytes.push_back(b);
+    }
+    mcu_.schedule(at, [this, bytes] { miso_.insert(miso_.end(), bytes.begin(), bytes.end()); });
+    return true;
+}
+
+// --- I2C -----------------------------------------------------------------
+
+std::uint8_t I2cRegisterDevice::load(std::uint8_t reg) const {
+    // A traced pair (reg, reg + 1) reads as big-endian int16.
+    if (auto it = traces_.find(reg); it != traces_.end()) {
+        const auto v = static_cast<std::int16_t>(std::lround(std::fmax(-32768.0, std::fmin(32767.0, it->second.at(mcu_.now())))));
+        return static_cast<std::uint8_t>(static_cast<std::uint16_t>(v) >> 8);
+    }
+    if (auto it = traces_.find(static_cast<std::uint8_t>(reg - 1)); it != traces_.end()) {
+        const auto v = static_cast<std::int16_t>(std::lround(std::fmax(-32768.0, std::fmin(32767.0, it->second.at(mcu_.now())))));
+        return static_cast<std::uint8_t>(static_cast<std::uint16_t>(v) & 0xFF);
+    }
+    return regs_[reg];
+}
+
+bool I2cRegisterDevice::write(const std::uint8_t* data, std::size_t n) {
+    if (n == 0) {
+        return true;
+    }
+    ptr_ = data[0];
+    for (std::size_t i = 1; i < n; ++i) {
+        regs_[ptr_++] = data[i];
+    }
+    return true;
+}
+
+bool I2cRegisterDevice::read(std::uint8_t* data, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        data[i] = load(ptr_++);
+    }
+    return true;
+}
+
+I2c::I2c(Mcu& mcu, std::string name, std::uint32_t bus_hz)
+    : Peripheral(mcu, std::move(name)), bit_time_((1000000000ull + bus_hz - 1) / bus_hz) {}
+
+bool I2c::write(std::uint8_t addr, const std::uint8_t* data, std::size_t n) {
+    const auto it = devs_.find(addr);
+    if (it == devs_.end()) {
+        bus_time(0);
+        ++nacks_;
+        return false;
+    }
+    bus_time(n);
+    return it->second->write(data, n);
+}
+
+bool I2c::read(std::uint8_t addr, std::uint8_t* data, std::size_t n) {
+    const auto it = devs_.find(addr);
+    if (it == devs_.end()) {
+        bus_time(0);
+        ++nacks_;
+        return false;
+    }
+    bus_time(n);
+    return it->second->read(data, n);
+}
+
+bool I2c::write_read(std::uint8_t addr, std::uint8_t reg, std::uint8_t* data, std::size_t n) {
+    return write(addr, &reg, 1) && read(addr, data, n);
+}
+
+I2cRegisterDevice* I2c::reg_device(std::uint8_t addr) {
+    if (devs_.count(addr) == 0) {
+        owned_.push_back(std::make_unique<I2cRegisterDevice>(mcu_));
+        devs_[addr] = owned_.back().get();
+    }
+    for (const auto& d : owned_) {
+        if (d.get() == devs_[addr]) {
+            return d.get();
+        }
+    }
+    return nullptr;
+}
+
+bool I2c::stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                   const std::string& base_dir, std::string& error) {
+    long long addr = 0;
+    if (!detail::parse_int(channel, addr) || addr < 0 || addr > 0x7F) {
+        error = "bad i2c address '" + channel + "'";
+        return false;
+    }
+    if (!expect_args(args, 3, "<bus>.<addr> reg <r> <bytes...> | trace <r> <file> [options]", error)) {
+        return false;
+    }
+    I2cRegisterDevice* dev = reg_device(static_cast<std::uint8_t>(addr));
+    if (dev == nullptr) {
+        error = "device at " + channel + " is not a register device";
+        return false;
+    }
+    std::uint8_t reg = 0;
+    if (!detail::parse_hex_byte(args[1], reg)) {
+        error = "bad register '" + args[1] + "'";
+        return false;
+    }
+    if (args[0] == "reg") {
+        std::vector<std::uint8_t> bytes;
+        for (std::size_t i = 2; i < args.size(); ++i) {
+            std::uint8_t b = 0;
+            if (!detail::parse_hex_byte(args[i], b)) {
+                error = "bad hex byte '" + args[i] + "'";
+                return false;
+            }
+            bytes.push_back(b);
+        }
+        mcu_.schedule(at, [dev, reg, bytes] {
+            for (std::size_t i = 0; i < bytes.size(); ++i) {
+                dev->set_reg(static_cast<std::uint8_t>(reg + i), bytes[i]);
+            }
+        });
+        return true;
+    }
+    if (args[0] == "trace") {
+        Trace trace;
+        if (!load_trace(args, 2, base_dir, at, trace, error)) {
+            return false;
+        }
+        mcu_.schedule(at, [dev, reg, t = std::move(trace)]() mutable { dev->attach_trace(reg, std::move(t)); });
+        return true;
+    }
+    error = "unknown i2c command '" + args[0] + "'";
+    return false;
+}
+
+// --- ADC -----------------------------------------------------------------
+
+Adc::Adc(Mcu& mcu, std::string name, int bits, Time conversion, int priority)
+    : Peripheral(mcu, name),
+      max_code_(static_cast<std::uint16_t>((1u << bits) - 1)),
+      conversion_(conversion),
+      irq_(mcu.add_irq(name, priority)) {}
+
+std::uint16_t Adc::sample(int channel) const {
+    const auto& trace = traces_[static_cast<std::size_t>(channel)];
+    const double v = trace ? trace->at(mcu_.now()) : levels_[static_cast<std::size_t>(channel)];
+    if (v <= 0) return 0;
+    if (v >= max_code_) return max_code_;
+    return static_cast<std::uint16_t>(v + 0.5);
+}
+
+bool Adc::start(int channel) {
+    if (busy_) {
+        return false;
+    }
+    busy_ = true;
+    mcu_.after(conversion_, [this, channel] {
+        if (eoc_) {
+            ++overruns_;
+        }
+        result_ = sample(channel);
+        eoc_ = true;
+        busy_ = false;
+        if (irq_on_) {
+            mcu_.raise(irq_);
+        }
+    });
+    return true;
+}
+
+std::uint16_t Adc::read() {
+    eoc_ = false;
+    return result_;
+}
+
+std::uint16_t Adc::convert(int channel) {
+    while (!start(channel)) {
+        mcu_.spend(conversion_ / 4);
+    }
+    while (busy_) {
+        mcu_.spend(conversion_ / 4);
+    }
+    return read();
+}
+
+void Adc::set_level(int channel, double counts) {
+    traces_[static_cast<std::size_t>(channel)].reset();
+    levels_[static_cast<std::size_t>(channel)] = counts;
+}
+
+void Adc::attach_trace(int channel, Trace trace) {
+    traces_[static_cast<std::size_t>(channel)] = std::make_unique<Trace>(std::move(trace));
+}
+
+bool Adc::stimulus(Time at, const std::string& channel, const std::vector<std::string>& args,
+                   const std::string& base_dir, std::string& error) {
+    int ch = 0;
+    if (!parse_channel(channel, kMaxChannels, ch, error) ||
+        !expect_args(args, 2, "<adc>.<ch> set <counts> | trace <file> [options]", error)) {
+        return false;
+    }
+    if (args[0] == "set") {
+        double v = 0;
+        if (!detail::parse_double(args[1], v)) {
+            error = "bad level '" + args[1] + "'";
+            return false;
+        }
+        mcu_.schedule(at, [this, ch, v] { set_level(ch, v); });
+        return true;
+    }
+    if (args[0] == "trace") {
+        Trace trace;
+        if (!load_trace(args, 1, base_dir, at, trace, error)) {
+            return false;
+        }
+        mcu_.schedule(at, [this, ch, t = std::move(trace)]() mutable { attach_trace(ch, std::move(t)); });
+        return true;
+    }
+    error = "unknown adc command '" + args[0] + "'";
+    return false;
+}
+
+// --- Timer ---------------------------------------------------------------
+
+Timer::Timer(Mcu& mcu, std::string name, int priority)
+    : Peripheral(mcu, name), irq_(mcu.add_irq(name, priority)) {}
+
+void Timer::start(Time period, bool periodic) {
+    period_ = period;
+    periodic_ = periodic;
+    running_ = true;
+    last_update_ = mcu_.now();
+    arm(mcu_.now() + period, ++generation_);
+}
+
+void Timer::arm(Time at, std::uint64_t gen) {
+    mcu_.schedule(at, [this, at, gen] {
+        if (gen != generation_) {
+            return;  // stopped or restarted since
+        }
+        ++updates_;
+        last_update_ = at;
+        mcu_.raise(irq_);
+        if (periodic_) {
+            arm(at + period_, gen);
+        } else {
+            running_ = false;
+        }
+    });
+}
+
+bool Timer::stimulus(Time at, const std::string&, const std::vector<std::string>& args,
+                     const std::string&, std::string& error) {
+    if (!expect_args(args, 1, "<timer> start <period> [once] | stop", error)) {
+        return false;
+    }
+    if (args[0] == "stop") {
+        mcu_.schedule(at, [this] { stop(); });
+        return true;
+    }
+    Time period = 0;
+    if (args[0] != "start" || args.size() < 2 || !detail::parse_time(args[1], period) || period == 0) {
+        error = "usage: <timer> start <period> [once] | stop";
+        return false;
+    }
+    const bool periodic = !(args.size() > 2 && args[2] == "once");
+    mcu_.schedule(at, [this, period, periodic] { start(period, periodic); });
+    return true;
+}
+
+}  // namespace g7::sim
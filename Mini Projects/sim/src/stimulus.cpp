@@ -0,0 +1,118 @@
+#include "g7/sim/stimulus.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "parse.hpp"
+
+namespace g7::sim {
+
+namespace {
+
+// Whitespace split honouring double quotes; stops at an unquoted '#'.
+bool tokenize(const std::string& line, std::vector<std::string>& out, std::string& error) {
+    out.clear();
+    std::string tok;
+    bool in_tok = false;
+    bool quoted = false;
+    for (char c : line) {
+        if (quoted) {
+            if (c == '"') {
+                quoted = false;
+            } else {
+                tok += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+            in_tok = true;
+        } else if (c == '#') {
+            break;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            if (in_tok) {
+                out.push_back(tok);
+                tok.clear();
+                in_tok = false;
+            }
+        } else {
+            tok += c;
+            in_tok = true;
+        }
+    }
+    if (quoted) {
+        error = "unterminated quote";
+        return false;
+    }
+    if (in_tok) {
+        out.push_back(tok);
+    }
+    return true;
+}
+
+}  // namespace
+
+bool load_stimulus_text(Mcu& mcu, const std::string& text, const std::string& base_dir,
+                        std::string& error) {
+    std::istringstream in(text);
+    std::string line;
+    std::vector<std::string> tok;
+    Time prev = 0;
+    for (int lineno = 1; std::getline(in, line); ++lineno) {
+        const std::string where = std::to_string(lineno) + ": ";
+        if (!tokenize(line, tok, error)) {
+            error = where + error;
+            return false;
+        }
+        if (tok.empty()) {
+            continue;
+        }
+        if (tok.size() < 3) {
+            error = where + "expected <time> <target> <command> [args...]";
+            return false;
+        }
+        const bool relative = tok[0][0] == '+';
+        Time at = 0;
+        if (!detail::parse_time(relative ? tok[0].substr(1) : tok[0], at)) {
+            error = where + "bad time '" + tok[0] + "'";
+            return false;
+        }
+        if (relative) {
+            at += prev;
+        }
+        prev = at;
+
+        const auto dot = tok[1].find('.');
+        const std::string name = tok[1].substr(0, dot);
+        const std::string channel = dot == std::string::npos ? "" : tok[1].substr(dot + 1);
+        Peripheral* p = mcu.find(name);
+        if (p == nullptr) {
+            error = where + "no peripheral named '" + name + "'";
+            return false;
+        }
+        const std::vector<std::string> args(tok.begin() + 2, tok.end());
+        if (!p->stimulus(at, channel, args, base_dir, error)) {
+            error = where + tok[1] + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool load_stimulus(Mcu& mcu, const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const auto slash = path.find_last_of('/');
+    const std::string dir = slash == std::string::npos ? "" : path.substr(0, slash);
+    if (!load_stimulus_text(mcu, ss.str(), dir, error)) {
+        error = path + ":" + error;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace g7::sim
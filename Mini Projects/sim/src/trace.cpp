@@ -0,0 +1,92 @@
+#include "g7/sim/trace.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace g7::sim {
+
+namespace {
+
+// Splits on commas, semicolons and whitespace; false if any field is not a number.
+bool split_numbers(const std::string& line, std::vector<double>& out) {
+    out.clear();
+    const char* p = line.c_str();
+    while (*p) {
+        while (*p == ',' || *p == ';' || *p == ' ' || *p == '\t' || *p == '\r') ++p;
+        if (!*p) break;
+        char* end = nullptr;
+        const double v = std::strtod(p, &end);
+        if (end == p) return false;
+        out.push_back(v);
+        p = end;
+    }
+    return !out.empty();
+}
+
+}  // namespace
+
+bool Trace::load(const std::string& path, double rate_hz, std::size_t col, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open trace " + path;
+        return false;
+    }
+    values_.clear();
+    times_.clear();
+    std::string line;
+    std::vector<double> fields;
+    while (std::getline(in, line)) {
+        if (!split_numbers(line, fields)) {
+            continue;
+        }
+        if (rate_hz > 0) {
+            if (col < fields.size()) values_.push_back(fields[col]);
+        } else if (col < fields.size() && fields.size() >= 2) {
+            times_.push_back(static_cast<Time>(fields[0] * 1e9 + 0.5));
+            values_.push_back(fields[col]);
+        }
+    }
+    if (values_.empty()) {
+        error = "no samples in trace " + path;
+        return false;
+    }
+    if (!times_.empty() && !std::is_sorted(times_.begin(), times_.end())) {
+        error = "timestamps in " + path + " are not increasing";
+        return false;
+    }
+    period_ = rate_hz > 0 ? static_cast<Time>(1e9 / rate_hz + 0.5) : 0;
+    return true;
+}
+
+void Trace::set_samples(std::vector<double> values, double rate_hz) {
+    values_ = std::move(values);
+    times_.clear();
+    period_ = static_cast<Time>(1e9 / rate_hz + 0.5);
+}
+
+Time Trace::duration() const {
+    if (values_.empty()) return 0;
+    return times_.empty() ? period_ * values_.size() : times_.back() - times_.front();
+}
+
+double Trace::at(Time t) const {
+    if (values_.empty()) {
+        return offset;
+    }
+    Time rel = t < start ? 0 : t - start;
+    std::size_t i = 0;
+    if (times_.empty()) {
+        i = static_cast<std::size_t>(rel / period_);
+        if (i >= values_.size()) i = loop ? i % values_.size() : values_.size() - 1;
+    } else {
+        rel += times_.front();
+        const Time span = times_.back() - times_.front();
+        if (loop && span > 0 && rel > times_.back()) rel = times_.front() + (rel - times_.front()) % span;
+        const auto it = std::upper_bound(times_.begin(), times_.end(), rel);
+        i = it == times_.begin() ? 0 : static_cast<std::size_t>(it - times_.begin()) - 1;
+    }
+    return values_[i] * scale + offset;
+}
+
+}  // namespace g7::sim
@@ -0,0 +1,83 @@
+// Simulator checks: stimulus lines take effect at their scheduled time, so a
+// level set at 0 holds until a trace on the same channel starts at 2 ms.
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "g7/sim/mcu.hpp"
+#include "g7/sim/peripherals.hpp"
+#include "g7/sim/stimulus.hpp"
+
+using namespace g7::sim;
+
+namespace {
+
+bool g_ok = true;
+
+void report(bool pass, const char* what, const std::string& detail) {
+    std::printf("%s %-34s %s\n", pass ? "ok      " : "MISMATCH", what, detail.c_str());
+    g_ok = g_ok && pass;
+}
+
+// 1 kHz ramp: 100, 200, ... 1000.
+bool write_ramp(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (f == nullptr) return false;
+    for (int i = 1; i <= 10; ++i) std::fprintf(f, "%d\n", i * 100);
+    return std::fclose(f) == 0;
+}
+
+int set_then_trace(const std::string& dir) {
+    Mcu mcu;
+    Adc& adc = mcu.add<Adc>("adc1");
+    I2c& i2c = mcu.add<I2c>("i2c1");
+    std::string error;
+    const bool loaded = load_stimulus_text(mcu,
+                                           "0    adc1.0      set   500\n"
+                                           "2ms  adc1.0      trace ramp.csv rate=1000\n"
+                                           "0    i2c1.0x68   reg   3b 01 f4\n"
+                                           "2ms  i2c1.0x68   trace 3b ramp.csv rate=1000\n",
+                                           dir, error);
+    if (!loaded) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    auto reg16 = [&] {
+        std::uint8_t b[2] = {};
+        i2c.write_read(0x68, 0x3b, b, 2);
+        return static_cast<int>(static_cast<std::int16_t>(b[0] << 8 | b[1]));
+    };
+    int adc_at[3], i2c_at[3];
+    const Time times[3] = {ms(1), ms(3), ms(4)};
+    for (int i = 0; i < 3; ++i) {
+        mcu.run_until(times[i]);
+        adc_at[i] = adc.convert(0);
+        i2c_at[i] = reg16();
+    }
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "%d at 1 ms, %d at 3 ms, %d at 4 ms", adc_at[0], adc_at[1], adc_at[2]);
+    report(adc_at[0] == 500 && adc_at[1] == 200 && adc_at[2] == 300, "adc: set, then trace at 2 ms", buf);
+    std::snprintf(buf, sizeof(buf), "%d at 1 ms, %d at 3 ms, %d at 4 ms", i2c_at[0], i2c_at[1], i2c_at[2]);
+    report(i2c_at[0] == 500 && i2c_at[1] == 200 && i2c_at[2] == 300, "i2c: reg, then trace at 2 ms", buf);
+    return 0;
+}
+
+}  // namespace
+
+int main() {
+    char dir[] = "/tmp/g7_sim_XXXXXX";
+    if (mkdtemp(dir) == nullptr) {
+        std::fprintf(stderr, "cannot create a temporary directory\n");
+        return 2;
+    }
+    const std::string ramp = std::string(dir) + "/ramp.csv";
+    int rc = write_ramp(ramp) ? set_then_trace(dir) : 2;
+    std::remove(ramp.c_str());
+    rmdir(dir);
+    if (rc == 0 && !g_ok) rc = 1;
+    return rc;
+}